@@ -2,19 +2,27 @@
 
 // Conntendo
 #include "ppu.h"
+#include "cpu.h"
+#include "console.h"
 
 #define HEADER_SIZE 16
 
 // Constructor
-Mapper::Mapper(u8* rom) : rom(rom)
+Mapper::Mapper(u8* rom, Console& console) : cpu(console.cpu), ppu(console.ppu), rom(rom)
 {
 	// Read ROM Header to get Cartridge Capacity
 	prgSize			= rom[4] * K_16;
 	chrSize			= rom[5] * K_8;
 	prgRAMSize		= rom[8] ? (rom[8] * K_8) : K_8;
-	PPU::SetMirrorMode( ( rom[6] & 0x01 ) ? PPU::VERTICAL : PPU::HORIZONTAL );
+	PPU::SetMirrorMode(ppu, ( rom[6] & 0x01 ) ? PPU::VERTICAL : PPU::HORIZONTAL );
+	memset(prgMap, 0, sizeof(prgMap));
+	memset(chrMap, 0, sizeof(chrMap));
 
 	this->prg		= rom + HEADER_SIZE; // Skip Header (16 bytes)
+	for (int i = 0; i < 4; i++)
+	{
+		prgBanks[i] = prg;
+	} // for
 	this->prgRAM	= new u8[prgRAMSize];
 	memset(this->prgRAM, 0, prgRAMSize * sizeof(u8)); 
 
@@ -30,6 +38,21 @@ Mapper::Mapper(u8* rom) : rom(rom)
 		this->chr	= new u8[chrSize];
 		memset(this->chr, 0, chrSize * sizeof(u8)); 
 	}
+	for (int i = 0; i < 8; i++)
+	{
+		chrBanks[i] = chr;
+	} // for
+	memset(ntBanks, 0, sizeof(ntBanks));
+
+	// Every tile gets decoded the first time it is looked up
+	chrDecoded	= new u8[chrSize * 4];
+	chrDirty	= new bool[chrSize / 16];
+	memset(chrDirty, true, (chrSize / 16) * sizeof(bool));
+
+	// Cartridge space starts out on the slow path, PRG RAM reads go straight through
+	CPU::SetPRGROM(cpu, prg, prgSize);
+	CPU::MapPages(cpu, MEMMAP_APU_IO, K_32 + K_16, nullptr, nullptr);
+	MapPRGRAM(true, false);
 
 } // Mapper()
 
@@ -42,6 +65,8 @@ Mapper::~Mapper()
 	{
 		delete chr;
 	}
+	delete[] chrDecoded;
+	delete[] chrDirty;
 
 } // ~Mapper()
 
@@ -49,9 +74,7 @@ u8 Mapper::read8(u16 address)
 {
 	if (address >= K_32) // PRG ROM
 	{
-		u16 offsetAddress	= (address - K_32);
-		u32 mapVal			= prgMap[offsetAddress / K_8];
-		return prg[ mapVal + (offsetAddress % K_8) ];
+		return prgBanks[(address >> 13) & 0x03][address & (K_8 - 1)];
 	}
 	else // PRG RAM
 	{
@@ -63,11 +86,52 @@ u8 Mapper::read8(u16 address)
 
 u8 Mapper::chr_read8(u16 address)
 {
-	u32 mapAddr = chrMap[address / K_1] + (address % K_1);
-	return chr[mapAddr];
+	return chrBanks[address / K_1][address % K_1];
 
 } // chr_read8()
 
+const u8* Mapper::chr_decoded(u16 address)
+{
+	// Fetches past the Pattern Tables ( unused Sprite slots ) are left to the planes read through the PPU
+	if (chrReadHook || address >= K_8)
+	{
+		return nullptr;
+	}
+	u32 mapAddr = chrMap[address / K_1] + (address % K_1);
+	u32 tile	= mapAddr / 16;
+	if (chrDirty[tile])
+	{
+		DecodeTile(tile);
+	}
+	return chrDecoded + (tile * 64) + ((mapAddr % 8) * 8);
+
+} // chr_decoded()
+
+u8 Mapper::StoreCHR(u32 offset, u8 val)
+{
+	chrDirty[offset / 16] = true;
+	return chr[offset] = val;
+
+} // StoreCHR()
+
+// Turn a tile's two bit planes into one palette index per pixel
+void Mapper::DecodeTile(u32 tile)
+{
+	u8* planes	= chr + (tile * 16);
+	u8* pixels	= chrDecoded + (tile * 64);
+	for (int row = 0; row < 8; row++)
+	{
+		u8 low	= planes[row];
+		u8 high = planes[row + 8];
+		for (int x = 0; x < 8; x++)
+		{
+			*pixels++ = ((low >> (7 - x)) & 1) | (((high >> (7 - x)) & 1) << 1);
+		} // for
+	} // for
+	chrDirty[tile] = false;
+
+} // DecodeTile()
+
 // PRG Mapping Function 
 void Mapper::MapPRG( int pageSize, int slot, int bank)
 {
@@ -77,11 +141,18 @@ void Mapper::MapPRG( int pageSize, int slot, int bank)
 		u8 numPages = prgSize / (K_1 * pageSize);
 		bank += numPages;
 	}
-	// Populate 8K pages
+	// Populate 8K pages, only the ones that change reach the CPU Page Table
 	for (int i = 0; i < (pageSize / 8); i++)
 	{
-		u8 curPage = ( (pageSize / 8) * slot) + i;
-		prgMap[curPage] = ( (pageSize * K_1 * bank) + (K_8 * i) ) % prgSize;
+		u8 curPage	= ( (pageSize / 8) * slot) + i;
+		u32 mapVal	= ( (pageSize * K_1 * bank) + (K_8 * i) ) % prgSize;
+		if (mapVal == prgMap[curPage] && (prgSlotsMapped & (1 << curPage)))
+		{
+			continue;
+		}
+		prgMap[curPage]		= mapVal;
+		prgBanks[curPage]	= prg + mapVal;
+		MapCPUSlot(curPage);
 
 	} // for
 
@@ -96,16 +167,54 @@ void Mapper::MapCHR(int pageSize, int slot, int bank)
 		u8 numPages = chrSize / (K_1 * pageSize);
 		bank += numPages;
 	}
-	// Populate 1K Pages
+	// Populate 1K Pages, only the ones that change reach the PPU Page Table
 	for (int i = 0; i < pageSize; i++)
 	{
-		u8 curPage = (pageSize * slot) + i;
-		chrMap[curPage] = ( (pageSize * K_1 * bank) + (K_1 * i) ) % chrSize;
+		u8 curPage	= (pageSize * slot) + i;
+		u32 mapVal	= ( (pageSize * K_1 * bank) + (K_1 * i) ) % chrSize;
+		if (mapVal == chrMap[curPage])
+		{
+			continue;
+		}
+		chrMap[curPage]		= mapVal;
+		chrBanks[curPage]	= chr + mapVal;
+		if (!chrReadHook)
+		{
+			PPU::SetCHRBank(ppu, curPage, chrBanks[curPage]);
+		}
 
 	} // for
 
 } // MapCHR()
 
+// Mirroring only goes to the PPU ( and rebuilds its Nametable pages ) when it changes
+void Mapper::SetMirrorMode(PPU::Mirroring mode)
+{
+	if (mirrorModeSet && mode == mirrorMode)
+	{
+		return;
+	}
+	mirrorMode		= mode;
+	mirrorModeSet	= true;
+	PPU::SetMirrorMode(ppu, mode);
+
+} // SetMirrorMode()
+
+// Point the CPU Page Table at the PRG ROM bank in an 8K slot
+void Mapper::MapCPUSlot(int slot)
+{
+	CPU::MapPages(cpu, K_32 + (K_8 * slot), K_8, prgBanks[slot], nullptr);
+	prgSlotsMapped |= 1 << slot;
+
+} // MapCPUSlot()
+
+// Let the CPU read/write PRG RAM ( $6000-$7FFF ) without going through the Mapper
+void Mapper::MapPRGRAM(bool readable, bool writable)
+{
+	CPU::MapPages(cpu, K_24, K_8, readable ? prgRAM : nullptr, writable ? prgRAM : nullptr);
+
+} // MapPRGRAM()
+
 MAPPER::SaveData Mapper::GrabSaveData()
 { 
 	return MAPPER::SaveData( prgRAM, chr, hasChrRAM, prgMap, chrMap );
@@ -120,6 +229,7 @@ void Mapper::LoadSaveData(MAPPER::SaveData loadedData)
 		{
 			chr[i] = loadedData.chrRAM[i];
 		} // for
+		memset(chrDirty, true, (chrSize / 16) * sizeof(bool));
 	}
 
 	for (int i = 0; i < K_8; i++)
@@ -128,12 +238,17 @@ void Mapper::LoadSaveData(MAPPER::SaveData loadedData)
 	} // for
 	for (int i = 0; i < 4; i++)
 	{
-		prgMap[i] = loadedData.prgMap[i];
+		prgMap[i]	= loadedData.prgMap[i];
+		prgBanks[i]	= prg + prgMap[i];
+		MapCPUSlot(i);
 	} // for
 	for (int i = 0; i < 8; i++)
 	{
-		chrMap[i] = loadedData.chrMap[i];
+		chrMap[i]	= loadedData.chrMap[i];
+		chrBanks[i]	= chr + chrMap[i];
 	} // for
+	PPU::SetCHRBanks(ppu, chr_banks());
+	mirrorModeSet = false; // the Mapper's SetBanks passes it on again
 
 } // LoadSaveData()
 
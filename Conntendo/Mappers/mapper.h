@@ -6,6 +6,14 @@
 
 #include <cstring>
 #include "common.h"
+#include "ppu.h"
+
+namespace CPU { class Core; } // cpu.h
+
+// Signals a Mapper subscribes to, the CPU and PPU never send the others
+#define MAPPER_HOOK_SCANLINE	0x01	// SignalScanline on cycle 260 of rendered scanlines
+#define MAPPER_HOOK_CPU			0x02	// ClockCPU as CPU cycles go by
+#define MAPPER_NO_EVENT			-1		// ClockCPU has nothing coming up
 
 namespace MAPPER
 {
@@ -65,7 +73,7 @@ class Mapper
 {
 public:
 
-	Mapper(u8* rom);
+	Mapper(u8* rom, Console& console);
 	~Mapper();
 
 	// Read-Write Functions
@@ -74,9 +82,24 @@ public:
 	virtual u8 chr_read8(u16 address);
 	virtual u8 chr_write8( u16 address, u8 val ) { return val; }
 
-	// IRQ Messaging between Mapper and System
+	// Decoded Pattern Row ( 8 pixels of 2-bit colour, left to right ) for a low plane address
+	// nullptr when the Mapper's CHR reads have side effects or the address is past $1FFF, callers then read the planes
+	const u8* chr_decoded(u16 address);
+
+	// The 1K CHR bank in each slot, for reading CHR without going through chr_read8
+	// nullptr when the Mapper's CHR reads have side effects ( kept in step by MapCHR )
+	u8* const* chr_banks() { return chrReadHook ? nullptr : chrBanks; }
+
+	// The 1K of Nametable RAM behind each Nametable when ciRAM is disabled, nullptr ones read through ReadExtraRAM
+	u8* const* nt_banks() { return ntBanks; }
+
+	// IRQ Messaging between Mapper and System ( MAPPER_HOOK bits the Mapper needs )
+	u8 hooks() { return signalHooks; }
 	virtual void SignalScanline() {} // for Scanline Counter IRQ (MMC3)
-	virtual void SignalCPU() {} // for CPU-Counter IRQ Systems (VRC4, FME-7)
+
+	// for CPU-Counter IRQ Systems (VRC4, FME-7), runs the counter on by a number of CPU cycles at once
+	// and returns the cycles until it next has to run ( its IRQ ), or MAPPER_NO_EVENT
+	virtual int ClockCPU(int cycles) { return MAPPER_NO_EVENT; }
 
 	// Extra vRAM on some rare cartridges ( Gauntlet )
 	virtual u8 ReadExtraRAM(u16 address) { return 0;  }
@@ -88,16 +111,29 @@ public:
 
 protected:
 
+	// Cores of the Console the Cartridge is plugged into
+	CPU::Core* cpu;
+	PPU::Core* ppu;
+
 	// PRG and CHR Address Map
 	u32 prgMap[4]; // Four  8K Slots
 	u32 chrMap[8]; // Eight 1K Slots
 
+	// The same Address Map as pointers into prg and chr
+	u8* prgBanks[4];
+	u8* chrBanks[8];
+	u8* ntBanks[4];
+
 	// Emulated Memory Pointers
 	u8* rom;
 	u8* prg;
 	u8* chr;
 	u8* prgRAM;
 
+	// Decoded copy of the CHR, 64 bytes per 16-byte tile, rebuilt lazily when a tile is dirty
+	u8* chrDecoded;
+	bool* chrDirty;
+
 	// Bank Sizes read from ROM
 	u32 prgSize;
 	u32 chrSize;
@@ -106,9 +142,59 @@ protected:
 	// Cartridge Flags
 	bool isLargeROM = false; // for specific mappers to determine if special-case
 	bool hasChrRAM  = false; // whether or not cartridge contains Chr RAM
+	bool chrReadHook = false; // chr_read8 does more than read the bank ( latches, split banks ), everything goes through it
+	u8 signalHooks = 0; // MAPPER_HOOK bits
+
+	// What the CPU and PPU were last told, so remapping only passes on what changed
+	u8 prgSlotsMapped		= 0; // 8K slots the CPU Page Table points at
+	bool mirrorModeSet		= false;
+	PPU::Mirroring mirrorMode;
 
-	// Memory Remapping 
+	// Memory Remapping, slots already holding the bank are left alone
 	void MapPRG(int pageSize, int slot, int bank);
 	void MapCHR(int pageSize, int slot, int bank);
+	void SetMirrorMode(PPU::Mirroring mode);
+
+	// CHR Writes ( keeps the decoded tile in step )
+	u8 StoreCHR(u32 offset, u8 val);
+	void DecodeTile(u32 tile);
+
+	// CPU Page Table Updates
+	void MapCPUSlot(int slot);
+	void MapPRGRAM(bool readable, bool writable);
 
-}; //Mapper
\ No newline at end of file
+}; //Mapper
+
+// A Mapper's entry points bound to its concrete class once it is loaded, the CPU and PPU call
+// through these instead of the virtual functions ( each one is the class's own code, so it can be inlined into it )
+struct MapperCalls
+{
+	Mapper* mapper	= nullptr;
+	u8 hooks		= 0; // MAPPER_HOOK bits
+
+	u8 (*read8)(Mapper* mapper, u16 address);
+	u8 (*write8)(Mapper* mapper, u16 address, u8 val);
+	u8 (*chr_read8)(Mapper* mapper, u16 address);
+	u8 (*chr_write8)(Mapper* mapper, u16 address, u8 val);
+	u8 (*ReadExtraRAM)(Mapper* mapper, u16 address);
+	u8 (*WriteExtraRAM)(Mapper* mapper, u16 address, u8 val);
+	void (*SignalScanline)(Mapper* mapper);
+	int (*ClockCPU)(Mapper* mapper, int cycles);
+
+	template <class MapperType>
+	void Bind(MapperType* concrete)
+	{
+		mapper			= concrete;
+		hooks			= concrete->hooks();
+		read8			= [](Mapper* m, u16 address)			{ return static_cast<MapperType*>(m)->MapperType::read8(address); };
+		write8			= [](Mapper* m, u16 address, u8 val)	{ return static_cast<MapperType*>(m)->MapperType::write8(address, val); };
+		chr_read8		= [](Mapper* m, u16 address)			{ return static_cast<MapperType*>(m)->MapperType::chr_read8(address); };
+		chr_write8		= [](Mapper* m, u16 address, u8 val)	{ return static_cast<MapperType*>(m)->MapperType::chr_write8(address, val); };
+		ReadExtraRAM	= [](Mapper* m, u16 address)			{ return static_cast<MapperType*>(m)->MapperType::ReadExtraRAM(address); };
+		WriteExtraRAM	= [](Mapper* m, u16 address, u8 val)	{ return static_cast<MapperType*>(m)->MapperType::WriteExtraRAM(address, val); };
+		SignalScanline	= [](Mapper* m)							{ static_cast<MapperType*>(m)->MapperType::SignalScanline(); };
+		ClockCPU		= [](Mapper* m, int cycles)				{ return static_cast<MapperType*>(m)->MapperType::ClockCPU(cycles); };
+
+	} // Bind()
+
+}; // MapperCalls
\ No newline at end of file
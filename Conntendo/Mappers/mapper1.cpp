@@ -7,7 +7,7 @@
 #define PRG_BANK_MODE	((control & 0x0C) >> 2)
 
 // Constructor
-Mapper1::Mapper1(u8* rom) : Mapper(rom)
+Mapper1::Mapper1(u8* rom, Console& console) : Mapper(rom, console)
 {
 	isLargeROM = (prgSize > K_256); 
 
@@ -43,6 +43,9 @@ void Mapper1::SetBanks()
 		break;
 	} // switch
 
+	// PRG RAM is only visible while enabled
+	MapPRGRAM(RAM_ENABLED, RAM_ENABLED);
+
 	// CHR Banking
 	bool is4KChrMode = (control & 0x10) && !isLargeROM;
 	if (is4KChrMode) // 4KB CHR Mode
@@ -78,9 +81,7 @@ u8 Mapper1::read8(u16 address)
 {
 	if (address >= K_32) // Read PRG ROM
 	{
-		u16 offsetAddress = (address - K_32);
-		u32 mapVal = prgMap[offsetAddress / K_8];
-		return prg[mapVal + (offsetAddress % K_8)];
+		return prgBanks[(address >> 13) & 0x03][address & (K_8 - 1)];
 	}
 	else if (RAM_ENABLED)// Read PRG RAM
 	{
@@ -147,7 +148,7 @@ u8 Mapper1::write8(u16 address, u8 val)
 
 u8 Mapper1::chr_write8(u16 address, u8 val)
 {
-	return chr[address] = val;
+	return StoreCHR(address, val);
 
 } // chr_write8()
 
@@ -3,10 +3,10 @@
 
 // MMC1 for Zelda, Metroid, Dragon Warrior etc
 // also accounts for non-standard MMC1 boards ( SOROM, SUROM etc )
-class Mapper1 : public Mapper
+class Mapper1 final : public Mapper
 {
 public:
-	Mapper1(u8* rom);
+	Mapper1(u8* rom, Console& console);
 	void SetBanks();
 
 	// Read-Write Functions
@@ -2,10 +2,10 @@
 #include "mapper.h"
 
 // MMC4 Japanese Tactic Games (Fire Emblem, Famicom Wars)
-class Mapper10 : public Mapper
+class Mapper10 final : public Mapper
 {
 public:
-	Mapper10(u8* rom);
+	Mapper10(u8* rom, Console& console);
 	void SetBanks();
 
 	// Read-Write Functions
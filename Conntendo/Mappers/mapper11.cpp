@@ -2,7 +2,7 @@
 #include "mapper11.h"
 
 // Constructor
-Mapper11::Mapper11(u8* rom) : Mapper(rom)
+Mapper11::Mapper11(u8* rom, Console& console) : Mapper(rom, console)
 {
 	bankSelect = 0;
 	SetBanks();
@@ -29,7 +29,7 @@ u8 Mapper11::write8(u16 address, u8 val)
 
 u8 Mapper11::chr_write8(u16 address, u8 val)
 { 
-	return chr[address] = val;
+	return StoreCHR(address, val);
 
 } // chr_write8()
 
@@ -2,10 +2,10 @@
 #include "mapper.h"
 
 // Color Dreams/ Wisdom Tree ROMs
-class Mapper11 : public Mapper
+class Mapper11 final : public Mapper
 {
 public:
-	Mapper11(u8* rom);
+	Mapper11(u8* rom, Console& console);
 	void SetBanks();
 
 	// Read-Write Functions
@@ -2,7 +2,7 @@
 #include "ppu.h"
 
 // Constructor
-Mapper2::Mapper2(u8* rom) : Mapper(rom),
+Mapper2::Mapper2(u8* rom, Console& console) : Mapper(rom, console),
 	shiftRegister(0x0),
 	vertMirroring(rom[6] & 0x01)
 {
@@ -33,7 +33,7 @@ u8 Mapper2::write8(u16 address, u8 val)
 
 u8 Mapper2::chr_write8(u16 address, u8 val)
 { 
-	return chr[address] = val;
+	return StoreCHR(address, val);
 
 } // chr_write8()
 
@@ -2,10 +2,10 @@
 #include "mapper.h"
 
 // NES-UxROMs such as Megaman, Castlevania, and Contra
-class Mapper2 : public Mapper
+class Mapper2 final : public Mapper
 {
 public:
-	Mapper2(u8* rom);
+	Mapper2(u8* rom, Console& console);
 	void SetBanks();
 
 	u8 write8(u16 address, u8 val);
@@ -12,7 +12,7 @@
 #define CHR_SLOT		((address >> 1) & 0x01) | ((address - 0xB000) >> 11)
 
 // Constructor
-Mapper25::Mapper25(u8* rom) : Mapper(rom)
+Mapper25::Mapper25(u8* rom, Console& console) : Mapper(rom, console)
 {
 	prgSelect0			= 0;
 	prgSelect1			= 0;
@@ -27,7 +27,9 @@ Mapper25::Mapper25(u8* rom) : Mapper(rom)
 	irqCounter		= 0;
 	irqAck			= 0;
 	irqMode			= 0;
+	signalHooks		= MAPPER_HOOK_CPU;
 
+	MapPRGRAM(true, true);
 	SetBanks();
 }
 
@@ -123,19 +125,19 @@ u8 Mapper25::write8(u16 address, u8 val)
 	// IRQ
 	if (address == 0xF000) // IRQ Latch, low 4 bits
 	{
-		CPU::Clear_IRQ();
+		CPU::Clear_IRQ(cpu);
 		irqLatch &= 0xF0; 
 		irqLatch |= val & 0x0F;
 	}
 	else if (address == 0xF001) // IRQ Latch, high 4 bits
 	{
-		CPU::Clear_IRQ();
+		CPU::Clear_IRQ(cpu);
 		irqLatch &= 0x0F;
 		irqLatch |= val << 4;
 	}
 	else if (address == 0xF002) // IRQ Control
 	{
-		CPU::Clear_IRQ();
+		CPU::Clear_IRQ(cpu);
 		irqPreScaler	= SIGNAL_COUNT;
 		irqCounter		= irqLatch;
 		irqControl		= val & 0x1;
@@ -144,60 +146,89 @@ u8 Mapper25::write8(u16 address, u8 val)
 	}
 	else if (address == 0xF003) // IRQ Acknowledge
 	{
-		CPU::Clear_IRQ();
+		CPU::Clear_IRQ(cpu);
 		irqAck = irqControl;
 	}
 
-	SetBanks();
+	// Bank and Mirroring registers remap, IRQ and PRG RAM writes do not
+	if (address >= 0x8000 && address <= 0xE003)
+	{
+		SetBanks();
+	}
 	return val;
 
 } // write8()
 
-u8 Mapper25::chr_read8(u16 address)
-{
-	u8 slot = address / K_1;
-	u32 mapAddr = chrMap[slot] + (address % K_1);
-	return chr[mapAddr];
-
-} // chr_read8()
-
 u8 Mapper25::chr_write8(u16 address, u8 val)
 { 
-	return chr[address] = val;
+	return StoreCHR(address, val);
 
 } // chr_write8()
 
-void Mapper25::ClockedIRQ()
+// HACK For some reason, 222 was value that lined up HUD in Bio Miracle Baby
+#define IRQ_COUNTER_FIRE	222
+
+// Counter clocks until it reaches IRQ_COUNTER_FIRE ( going the long way round if it is past it )
+int Mapper25::ClocksToIRQ()
 {
-	irqCounter++;
-	// HACK For some reason, 222 was value that lined up HUD in Bio Miracle Baby
-	if (irqCounter == 222 )
+	return ((IRQ_COUNTER_FIRE - irqCounter - 1) & 0xFFFF) + 1;
+
+} // ClocksToIRQ()
+
+void Mapper25::ClockedIRQ(int clocks)
+{
+	while (clocks >= ClocksToIRQ())
 	{
+		clocks -= ClocksToIRQ();
 		irqCounter = irqLatch;
-		CPU::Set_IRQ();
-	}
+		CPU::Set_IRQ(cpu);
+	} // while
+	irqCounter = (s16)(irqCounter + clocks);
+
 } // ClockedIRQ()
 
-void Mapper25::SignalCPU()
+// CPU cycles until the Prescaler clocks the counter ( 3 dots a cycle out of 341 a scanline )
+int Mapper25::PreScalerCycles(s16 preScaler)
+{
+	return (preScaler > 0) ? (preScaler + 2) / 3 : 1;
+
+} // PreScalerCycles()
+
+int Mapper25::ClockCPU(int cycles)
 {
-	if (irqAck)
+	if (!irqAck)
 	{
-		if (irqMode) // Cycle Mode
-		{
-			ClockedIRQ();
-		}
-		else // Scanline Mode
-		{
-			irqPreScaler -= 3;
-			if (irqPreScaler <= 0)
-			{
-				irqPreScaler += SIGNAL_COUNT;
-				ClockedIRQ();
-			}
-		}
+		return MAPPER_NO_EVENT;
 	}
 
-} // SignalCPU()
+	if (irqMode) // Cycle Mode
+	{
+		ClockedIRQ(cycles);
+		return ClocksToIRQ();
+	}
+
+	// Scanline Mode
+	while (cycles >= PreScalerCycles(irqPreScaler))
+	{
+		int toClock		= PreScalerCycles(irqPreScaler);
+		cycles			-= toClock;
+		irqPreScaler	+= SIGNAL_COUNT - (3 * toClock);
+		ClockedIRQ(1);
+	} // while
+	irqPreScaler -= 3 * cycles;
+
+	// Walk the Prescaler forward to the IRQ, a frame's worth of scanlines at most ( waking early is harmless )
+	int toIRQ		= 0;
+	s16 preScaler	= irqPreScaler;
+	for (int clocks = ClocksToIRQ(); clocks > 0 && toIRQ < K_32; clocks--)
+	{
+		int toClock	= PreScalerCycles(preScaler);
+		toIRQ		+= toClock;
+		preScaler	+= SIGNAL_COUNT - (3 * toClock);
+	} // for
+	return toIRQ;
+
+} // ClockCPU()
 
 MAPPER::SaveData Mapper25::GrabSaveData()
 {
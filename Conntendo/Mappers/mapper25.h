@@ -3,19 +3,18 @@
 
 // CURRENTLY WORK IN PROGRESS (CHR Mapping is faulty)
 // VRC4 Konami ROMs
-class Mapper25 : public Mapper
+class Mapper25 final : public Mapper
 {
 public:
-	Mapper25(u8* rom);
+	Mapper25(u8* rom, Console& console);
 	void SetBanks();
 
 	// Read-Write Functions
 	u8 write8(u16 address, u8 val);
-	u8 chr_read8(u16 address);
 	u8 chr_write8(u16 address, u8 val);
 
 	// IRQ Signal
-	void SignalCPU();
+	int ClockCPU(int cycles);
 
 	// SaveStates
 	MAPPER::SaveData GrabSaveData();
@@ -38,6 +37,8 @@ private:
 	s16 irqCounter;
 
 	// Helper Functions
-	void ClockedIRQ();
+	int ClocksToIRQ();
+	void ClockedIRQ(int clocks);
+	int PreScalerCycles(s16 preScaler);
 	void UpdateCHRSelect(u8 val, bool writeToHigh, u8 slot);
 };
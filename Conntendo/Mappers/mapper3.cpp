@@ -2,7 +2,7 @@
 #include "mapper3.h"
 
 // Constructor
-Mapper3::Mapper3(u8* rom) : Mapper(rom),
+Mapper3::Mapper3(u8* rom, Console& console) : Mapper(rom, console),
 	shiftRegister(0x0),
 	vertMirroring(rom[6] & 0x01)
 {
@@ -34,7 +34,7 @@ u8 Mapper3::write8(u16 address, u8 val)
 
 u8 Mapper3::chr_write8(u16 address, u8 val)
 { 
-	return chr[address] = val;
+	return StoreCHR(address, val);
 
 } // chr_write8()
 
@@ -3,10 +3,10 @@
 
 // NES CNROMs for early games like Gradius and Arkanoid
 // CHR Bank Swapping Only
-class Mapper3 : public Mapper
+class Mapper3 final : public Mapper
 {
 public:
-	Mapper3(u8* rom);
+	Mapper3(u8* rom, Console& console);
 	void SetBanks();
 
 	u8 write8(u16 address, u8 val);
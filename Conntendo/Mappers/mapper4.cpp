@@ -8,7 +8,7 @@
 #define MIRROR_MODE		(val & 0x01)
 
 // Constructor
-Mapper4::Mapper4(u8* rom) : Mapper(rom)
+Mapper4::Mapper4(u8* rom, Console& console) : Mapper(rom, console)
 {
 	memset(bankData, 0, sizeof(bankData[0]));
 	bankSelect = 0;
@@ -18,8 +18,16 @@ Mapper4::Mapper4(u8* rom) : Mapper(rom)
 	irqReload = 0;
 	irqDisable = false;
 	irqEnable = false;
+	signalHooks = MAPPER_HOOK_SCANLINE;
+
+	// Four Screen carts read their Nametables straight out of extraRAM
+	for (int i = 0; i < 4; i++)
+	{
+		ntBanks[i] = extraRAM + (K_1 * i);
+	} // for
 
 	MapPRG( 8, 3, -1); // CPU $E000 - $FFFF: 8 KB PRG ROM bank, always fixed to the last bank
+	MapPRGRAM(true, true);
 	SetBanks();
 }
 
@@ -87,12 +95,15 @@ u8 Mapper4::write8(u16 address, u8 val)
 		{
 		case 0x8000:  
 			bankSelect = val;
+			SetBanks();
 			break;
 		case 0x8001:  
 			bankData[MAP_INDEX] = val;
+			SetBanks();
 			break;
 		case 0xA000:
 			horMirroring = MIRROR_MODE;
+			SetMirrorMode((horMirroring) ? PPU::Mirroring::HORIZONTAL : PPU::Mirroring::VERTICAL);
 			break;
 		case 0xC000:
 			irqLatch = val;	
@@ -101,14 +112,13 @@ u8 Mapper4::write8(u16 address, u8 val)
 			irqReload = 0;
 			break;
 		case 0xE000:
-			CPU::Clear_IRQ(); 
+			CPU::Clear_IRQ(cpu); 
 			irqEnable = false;
 			break;
 		case 0xE001:
 			irqEnable = true;	
 			break;
-		}
-		SetBanks();
+		} // switch ( IRQ writes leave the banks alone )
 	}
 	return val;
 
@@ -116,7 +126,7 @@ u8 Mapper4::write8(u16 address, u8 val)
 
 u8 Mapper4::chr_write8(u16 address, u8 val)
 { 
-	return chr[address] = val;
+	return StoreCHR(address, val);
 
 } // chr_write8()
 
@@ -134,7 +144,7 @@ void Mapper4::SignalScanline()
 
 	if (irqEnable && irqReload == 0 )
 	{
-		CPU::Set_IRQ();
+		CPU::Set_IRQ(cpu);
 	}
 
 } // SignalScanline()
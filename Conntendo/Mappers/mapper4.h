@@ -2,10 +2,10 @@
 #include "mapper.h"
 
 // MMC3 for Super Mario 3, Kirbys Adventure etc
-class Mapper4 : public Mapper
+class Mapper4 final : public Mapper
 {
 public:
-	Mapper4(u8* rom);
+	Mapper4(u8* rom, Console& console);
 	void SetBanks();
 
 	u8 write8(u16 address, u8 val);
@@ -12,8 +12,11 @@
 #define EXTRA_RAM_WP	(ramExtraMode == 3)
 
 // Constructor
-Mapper5::Mapper5(u8* rom) : Mapper(rom)
+Mapper5::Mapper5(u8* rom, Console& console) : Mapper(rom, console)
 {
+	// CHR banks depend on whether the PPU is fetching sprites or background
+	chrReadHook = true;
+
 	// Modes Default to 3 at Startup
 	prgBankMode = 3; 
 	chrBankMode = 3;
@@ -34,6 +37,7 @@ Mapper5::Mapper5(u8* rom) : Mapper(rom)
 	irqEnable = false;
 	irqPending = false;
 	inFrame = false;
+	signalHooks = MAPPER_HOOK_SCANLINE | MAPPER_HOOK_CPU;
 
 	// Multiply
 	multiplicand = 0;
@@ -62,7 +66,10 @@ Mapper5::Mapper5(u8* rom) : Mapper(rom)
 	memset(extraRAM, 0xFF, K_1);
 
 	// Use own NameTable Lookup
-	PPU::DisableCIRAM(true);
+	PPU::DisableCIRAM(ppu, true);
+
+	// PRG RAM reads come from the larger RAM, writes are protected
+	CPU::MapPages(cpu, K_24, K_8, lgPrgRAM, nullptr);
 
 	SetBanks();
 
@@ -248,7 +255,7 @@ u8 Mapper5::write8(u16 address, u8 val)
 		irqEnable = (val & 0x80);
 		if (irqEnable && irqPending)
 		{
-			CPU::Set_IRQ();
+			CPU::Set_IRQ(cpu);
 		}
 		break;
 	case 0x5205: // Multiply Instruction
@@ -288,7 +295,11 @@ u8 Mapper5::write8(u16 address, u8 val)
 		}
 	}
 
-	SetBanks();
+	// Only the Mode, Bank and Upper Bit registers remap
+	if (address >= 0x5100 && address <= 0x5130)
+	{
+		SetBanks();
+	}
 	return val;
 
 } // write8()
@@ -301,9 +312,10 @@ u8 Mapper5::read8(u16 address)
 	}
 	else if (address == 0x5204) // Read IRQ Status
 	{
+		UpdateInFrame(); // PPU was just caught up, refresh inFrame against it
 		u8 irqStatus = (inFrame << 6) | (irqPending << 7);
 		irqPending = false;
-		CPU::Clear_IRQ();
+		CPU::Clear_IRQ(cpu);
 		return irqStatus;
 	}
 	else if (address == 0x5205) // Multiply Insturction Lower
@@ -328,9 +340,7 @@ u8 Mapper5::read8(u16 address)
 	}
 	else // PRG ROM
 	{
-		u16 offsetAddress = (address - K_32);
-		u32 mapVal = prgMap[offsetAddress / K_8];
-		return prg[mapVal + (offsetAddress % K_8)];
+		return prgBanks[(address >> 13) & 0x03][address & (K_8 - 1)];
 	}
 	return 0;
 
@@ -361,12 +371,12 @@ u8 Mapper5::chr_read8(u16 address)
 
 	if (EXTRA_ATTRMODE)
 	{
-		bool useSprTiles = (PPU::GetCycle() > 320 && PPU::GetCycle() <= 321); // Grab Sprite Pixels occurs on dot 321 (setting == doesnt work)
+		bool useSprTiles = (PPU::GetCycle(ppu) > 320 && PPU::GetCycle(ppu) <= 321); // Grab Sprite Pixels occurs on dot 321 (setting == doesnt work)
 		mapAddr += (useSprTiles) ? chrMap[slot] : bgChrMap[slot];
 	}
 	else
 	{
-		bool useBgTiles = !(PPU::GetCycle() > 257 && PPU::GetCycle() <= 321); // not exactly sure why this range
+		bool useBgTiles = !(PPU::GetCycle(ppu) > 257 && PPU::GetCycle(ppu) <= 321); // not exactly sure why this range
 		mapAddr += (useBgTiles) ? bgChrMap[slot] : chrMap[slot];
 	}
 	return chr[mapAddr];
@@ -375,7 +385,7 @@ u8 Mapper5::chr_read8(u16 address)
 
 u8 Mapper5::chr_write8(u16 address, u8 val)
 {
-	return chr[address] = val;
+	return StoreCHR(address, val);
 
 } // chr_write8()
 
@@ -449,15 +459,26 @@ u8 Mapper5::WriteExtraRAM(u16 address, u8 val)
 } // WriteExtraRAM()
 
 // For keeping track if PPU is Rendering
-void Mapper5::SignalCPU()
+void Mapper5::UpdateInFrame()
 {
-	bool isVisibleScanline = (PPU::GetScanline() >= 0 && PPU::GetScanline() <= 239+PPU::GetDebugValue());
-	if (!PPU::IsRendering() || !isVisibleScanline)
+	bool isVisibleScanline = (PPU::GetScanline(ppu) >= 0 && PPU::GetScanline(ppu) <= 239+PPU::GetDebugValue(ppu));
+	if (!PPU::IsRendering(ppu) || !isVisibleScanline)
 	{
 		inFrame = false;
 	}
 
-} // SignalCPU()
+} // UpdateInFrame()
+
+// Looks at the PPU after every instruction, so the next one is always due
+int Mapper5::ClockCPU(int cycles)
+{
+	if (cycles > 0)
+	{
+		UpdateInFrame();
+	}
+	return 1;
+
+} // ClockCPU()
 
 // Handle Scanline-Based IRQ Signal
 void Mapper5::SignalScanline()
@@ -467,7 +488,7 @@ void Mapper5::SignalScanline()
 		inFrame = true;
 		irqPending = false;
 		scanlineCounter = 0;
-		CPU::Clear_IRQ();
+		CPU::Clear_IRQ(cpu);
 	}
 	else
 	{
@@ -477,7 +498,7 @@ void Mapper5::SignalScanline()
 			irqPending = true;
 			if (irqEnable)
 			{
-				CPU::Set_IRQ();
+				CPU::Set_IRQ(cpu);
 			}
 		}
 	}
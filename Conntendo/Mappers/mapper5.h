@@ -2,12 +2,12 @@
 #include "mapper.h"
 
 // MMC5 (The Ultimate Mapper)
-class Mapper5 : public Mapper
+class Mapper5 final : public Mapper
 {
 public:
 
 	// Setup
-	Mapper5(u8* rom);
+	Mapper5(u8* rom, Console& console);
 	void SetBanks();
 
 	// Read-Write Functions
@@ -22,7 +22,7 @@ public:
 
 	// IRQ
 	void SignalScanline();
-	void SignalCPU(); // for checking if stop rendering
+	int ClockCPU(int cycles); // for checking if stop rendering
 
 	// SaveStates
 	MAPPER::SaveData GrabSaveData();
@@ -34,6 +34,7 @@ private:
 	u8 ReadAudio(u16 address);
 	u8 WriteAudio(u16 address, u8 val);
 	u8 WriteToRAM(u16 address, u8 val);
+	void UpdateInFrame();
 	void Mapper5::MapChrBG(int pageSize, int slot, int bank);
 
 	u8 prgBankMode; // To determine one of four PRG Banking Modes 
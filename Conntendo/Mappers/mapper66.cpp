@@ -5,7 +5,7 @@
 #define CHR_SHIFT (shiftRegister & 0x03)
 
 // Constructor
-Mapper66::Mapper66(u8* rom) : Mapper(rom)
+Mapper66::Mapper66(u8* rom, Console& console) : Mapper(rom, console)
 {
 	shiftRegister = 0;
 	SetBanks();
@@ -32,7 +32,7 @@ u8 Mapper66::write8(u16 address, u8 val)
 
 u8 Mapper66::chr_write8(u16 address, u8 val)
 { 
-	return chr[address] = val;
+	return StoreCHR(address, val);
 
 } // chr_write8()
 
@@ -2,10 +2,10 @@
 #include "mapper.h"
 
 // NES-GxROMs for Dragon Power, Gumshoe etc
-class Mapper66 : public Mapper
+class Mapper66 final : public Mapper
 {
 public:
-	Mapper66(u8* rom);
+	Mapper66(u8* rom, Console& console);
 	void SetBanks();
 
 	// Read-Write Functions
@@ -8,7 +8,7 @@
 #define ROM_BIT		(!(prgBank[0] & 0x40))
 
 // Constructor
-Mapper69::Mapper69(u8* rom) : Mapper(rom)
+Mapper69::Mapper69(u8* rom, Console& console) : Mapper(rom, console)
 {
 	command = 0;
 	parameter = 0;
@@ -17,10 +17,12 @@ Mapper69::Mapper69(u8* rom) : Mapper(rom)
 	irqEnable = false;
 	irqCounterEnable = false;
 	irqCounter = 0;
+	signalHooks = MAPPER_HOOK_CPU;
 
 	memset(prgBank, 0, 4 * sizeof(u8));
 	memset(chrBank, 0, 8 * sizeof(u8));
 
+	MapPRGRAM(false, false); // $6000-$7FFF can be RAM or ROM
 	SetBanks();
 }
 
@@ -81,7 +83,7 @@ void Mapper69::Command()
 	}
 	else if (command == 0xD) // IRQ Control
 	{
-		CPU::Clear_IRQ();
+		CPU::Clear_IRQ(cpu);
 		irqEnable = parameter & 0x01;
 		irqCounterEnable = parameter & 0x80;
 	}
@@ -114,9 +116,7 @@ u8 Mapper69::read8(u16 address)
 	}
 	else if (address >= K_32) // PRG ROM
 	{
-		u16 offsetAddress = (address - K_32);
-		u32 prgAddr = prgMap[offsetAddress / K_8] + (offsetAddress % K_8);
-		return prg[prgAddr];
+		return prgBanks[(address >> 13) & 0x03][address & (K_8 - 1)];
 	}
 
 } // read8()
@@ -137,8 +137,11 @@ u8 Mapper69::write8(u16 address, u8 val)
 	{
 		parameter = val;
 		Command();
+		if (command <= 0xC) // Bank and Mirroring Commands, the rest are IRQ
+		{
+			SetBanks();
+		}
 	}
-	SetBanks();
 
 	return val;
 
@@ -146,24 +149,36 @@ u8 Mapper69::write8(u16 address, u8 val)
 
 u8 Mapper69::chr_write8(u16 address, u8 val)
 { 
-	return chr[address] = val;
+	return StoreCHR(address, val);
 
 } // chr_write8()
 
-// CPU-Based IRQ System
-void Mapper69::SignalCPU()
+// CPU-Based IRQ System, the counter goes down once a cycle
+int Mapper69::ClockCPU(int cycles)
 {
-	if (irqCounterEnable)
+	if (!irqCounterEnable)
 	{
-		irqCounter--;
-		if (irqEnable && irqCounter <= 0)
-		{
-			CPU::Set_IRQ();
-			irqCounter = 0xFFFF;
-		}
+		return MAPPER_NO_EVENT;
 	}
+	if (!irqEnable)
+	{
+		irqCounter -= cycles;
+		return MAPPER_NO_EVENT;
+	}
+
+	// IRQ on the cycle the counter reaches 0, then it starts again from $FFFF
+	int toIRQ = (irqCounter > 1) ? irqCounter : 1;
+	while (cycles >= toIRQ)
+	{
+		cycles -= toIRQ;
+		CPU::Set_IRQ(cpu);
+		irqCounter	= 0xFFFF;
+		toIRQ		= irqCounter;
+	} // while
+	irqCounter -= cycles;
+	return (irqCounter > 1) ? irqCounter : 1;
 
-} // SignalCPU()
+} // ClockCPU()
 
 MAPPER::SaveData Mapper69::GrabSaveData()
 {
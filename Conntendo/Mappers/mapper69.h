@@ -2,10 +2,10 @@
 #include "mapper.h"
 
 // Sunsoft FME-7 ROMs ( Batman Return of the Joker )
-class Mapper69 : public Mapper
+class Mapper69 final : public Mapper
 {
 public:
-	Mapper69(u8* rom);
+	Mapper69(u8* rom, Console& console);
 	void SetBanks();
 
 	// Read-Write Functions
@@ -14,7 +14,7 @@ public:
 	u8 chr_write8(u16 address, u8 val);
 
 	// CPU IRQ
-	void SignalCPU();
+	int ClockCPU(int cycles);
 
 	// SaveStates
 	MAPPER::SaveData GrabSaveData();
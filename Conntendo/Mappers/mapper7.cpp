@@ -2,7 +2,7 @@
 #include "mapper7.h"
 
 // Constructor
-Mapper7::Mapper7(u8* rom) : Mapper(rom)
+Mapper7::Mapper7(u8* rom, Console& console) : Mapper(rom, console)
 {
 	shiftRegister = 0;
 	SetBanks();
@@ -31,6 +31,6 @@ u8 Mapper7::write8(u16 address, u8 val)
 
 u8 Mapper7::chr_write8(u16 address, u8 val)
 { 
-	return chr[address] = val;
+	return StoreCHR(address, val);
 
 } // chr_write8()
@@ -2,10 +2,10 @@
 #include "mapper.h"
 
 // NES AxROMs for RARE games: RC-ProAM, Battletoads etc
-class Mapper7 : public Mapper
+class Mapper7 final : public Mapper
 {
 public:
-	Mapper7(u8* rom);
+	Mapper7(u8* rom, Console& console);
 	void SetBanks();
 
 	u8 write8(u16 address, u8 val);
@@ -7,8 +7,11 @@
 #define PRG_BANK	(val & 0x0F)
 
 // Constructor
-Mapper9::Mapper9(u8* rom) : Mapper(rom)
+Mapper9::Mapper9(u8* rom, Console& console) : Mapper(rom, console)
 {
+	// Reading the latch tiles switches banks
+	chrReadHook = true;
+
 	prgBankSelect = 0;
 	chrBankSelectA = 0;
 	chrBankSelectB = 0;
@@ -111,15 +114,14 @@ u8 Mapper9::chr_read8(u16 address)
 		MapCHR(4, 1, chrBankSelectB);
 	}	
 	
-	u32 chrAddress = chrMap[address / K_1] + (address % K_1);
-	return chr[chrAddress];
+	return chrBanks[address / K_1][address % K_1];
 
 } // chr_read8()
 
 
 u8 Mapper9::chr_write8(u16 address, u8 val)
 {
-	return chr[address] = val;
+	return StoreCHR(address, val);
 
 } // chr_write8()
 
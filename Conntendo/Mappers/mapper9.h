@@ -2,10 +2,10 @@
 #include "mapper.h"
 
 // MMC2 used ONLY for Punch Out
-class Mapper9 : public Mapper
+class Mapper9 final : public Mapper
 {
 public:
-	Mapper9(u8* rom);
+	Mapper9(u8* rom, Console& console);
 	void SetBanks();
 
 	// Read-Write Functions
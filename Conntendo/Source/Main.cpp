@@ -15,6 +15,7 @@
 #include "palette.h"
 #include "dev.h"
 #include "files.h"
+#include "display.h"
 
 // SDL
 #include "SDL_syswm.h"
@@ -53,8 +54,10 @@ gcroot<ToolStripMenuItem^> menu_Audio;
 gcroot<ToolStripMenuItem^>	subMenu_DebugDisplay;
 gcroot<ToolStripMenuItem^>	subMenu_DebugSpeed;
 gcroot<ToolStripMenuItem^>	subMenu_Palette;
+gcroot<ToolStripMenuItem^>	subMenu_FrameSkip;
 gcroot<ToolStripItem^>		subMenu_DebugSpeedPrev;
 gcroot<ToolStripItem^>		subMenu_PalettePrev;
+gcroot<ToolStripItem^>		subMenu_FrameSkipPrev;
 
 // WinForm Toolbar
 gcroot<ToolStripContainer^> toolStripContainer;
@@ -76,7 +79,8 @@ enum MENU_BUTTON
 	Audio		= 6,
 	Test		= 7,
 	Test2		= 8,
-	Batch		= 9
+	Batch		= 9,
+	Threads		= 10
 };
 
 enum MENU_NES
@@ -94,7 +98,8 @@ enum MENU_OPTIONS
 	PatternTable			= 2,
 	DrawScanlines			= 3,
 	AllowNonIntegerScale	= 4,
-	ScreenFilter			= 5
+	NTSCFilter				= 5,
+	ScreenFilter			= 6
 };
 
 enum MENU_DEBUGDISPLAY
@@ -114,6 +119,16 @@ enum MENU_SPEED
 	Double		= 4
 };
 
+enum MENU_FRAMESKIP
+{
+	SkipNone	= 0,
+	SkipOne		= 1,
+	SkipTwo		= 2,
+	SkipThree	= 3,
+	SkipAuto	= 4,
+	SkipAll		= 5
+};
+
 enum MENU_AUDIO
 {
 	Increase		= 0,
@@ -314,6 +329,9 @@ void CloseEmulator()
 	ptScreen.Destroy();
 	inputScreen.Destroy();
 
+	// Stop Frame Conversion
+	Display::Shutdown();
+
 	runEmulator = false;
 	Application::Exit();
 
@@ -633,6 +651,9 @@ void toolStrip_ButtonClick(Object^ sender,ToolStripItemClickedEventArgs^ e)
 	case MENU_BUTTON::Batch:
 		Dev::EnableBatchTest(false);
 		break;
+	case MENU_BUTTON::Threads:
+		Dev::TestConsoleThreads( Dev::GetTestPath("castlevania3") );
+		break;
 
 	} // switch
 
@@ -681,6 +702,9 @@ void menu_Options_ButtonClick(Object^ sender, ToolStripItemClickedEventArgs^ e)
 		e->ClickedItem->BackColor = Emulator::ToggleAllowNonIntegerScaling() ? COLOR_ACTIVE : COLOR_IDLE;
 		AdjustGameWindow();
 		break;
+	case MENU_OPTIONS::NTSCFilter:
+		e->ClickedItem->BackColor = Emulator::ToggleNTSCFilter() ? COLOR_ACTIVE : COLOR_IDLE;
+		break;
 	case MENU_OPTIONS::ScreenFilter:
 		e->ClickedItem->BackColor = SetScreenFilter() ? COLOR_ACTIVE : COLOR_IDLE;
 		break;
@@ -804,6 +828,40 @@ void subMenu_DebugSpeed_ButtonClick(Object^ sender, ToolStripItemClickedEventArg
 
 } // subMenu_DebugSpeed_ButtonClick()
 
+// Frame Skipping Options Submenu
+void subMenu_FrameSkip_ButtonClick(Object^ sender, ToolStripItemClickedEventArgs^ e)
+{
+	e->ClickedItem->BackColor = COLOR_ACTIVE;
+	if (subMenu_FrameSkipPrev.operator->() != nullptr)
+	{
+		subMenu_FrameSkipPrev->BackColor = COLOR_IDLE;
+	}
+
+	switch (subMenu_FrameSkip->DropDownItems->IndexOf(e->ClickedItem))
+	{
+	case MENU_FRAMESKIP::SkipNone:
+		Emulator::SetFrameSkip(FRAMESKIP_NONE);
+		break;
+	case MENU_FRAMESKIP::SkipOne:
+		Emulator::SetFrameSkip(1);
+		break;
+	case MENU_FRAMESKIP::SkipTwo:
+		Emulator::SetFrameSkip(2);
+		break;
+	case MENU_FRAMESKIP::SkipThree:
+		Emulator::SetFrameSkip(3);
+		break;
+	case MENU_FRAMESKIP::SkipAuto:
+		Emulator::SetFrameSkip(FRAMESKIP_AUTO);
+		break;
+	case MENU_FRAMESKIP::SkipAll:
+		Emulator::SetFrameSkip(FRAMESKIP_HEADLESS);
+		break;
+	}
+	subMenu_FrameSkipPrev = e->ClickedItem;
+
+} // subMenu_FrameSkip_ButtonClick()
+
 // Palette Selecting Options Submenu
 void subMenu_Palette_ButtonClick(Object^ sender, ToolStripItemClickedEventArgs^ e)
 {
@@ -836,6 +894,19 @@ void subMenu_Palette_ButtonClick(Object^ sender, ToolStripItemClickedEventArgs^
 	case Palette::Colorspace::EGA:
 		Palette::SetPalette(Palette::Colorspace::EGA);
 		break;
+	case Palette::Colorspace::CUSTOM:
+		if ( !Palette::LoadPaletteFile(Emulator::GetResourcesPath() + PALETTE_FILE) )
+		{
+			Emulator::ShowMessage("No Palette File in Resources");
+			e->ClickedItem->BackColor = COLOR_IDLE; // keep the current selection
+			if (subMenu_PalettePrev.operator->() != nullptr)
+			{
+				subMenu_PalettePrev->BackColor = COLOR_ACTIVE;
+			}
+			return;
+		}
+		Palette::SetPalette(Palette::Colorspace::CUSTOM);
+		break;
 	} // switch
 	subMenu_PalettePrev = e->ClickedItem;
 
@@ -941,6 +1012,17 @@ void SetupWinForms()
 	subMenu_DebugSpeed->DropDownItems->Add("2.0x");
 	subMenu_DebugSpeed->DropDownItemClicked += gcnew System::Windows::Forms::ToolStripItemClickedEventHandler(&subMenu_DebugSpeed_ButtonClick);
 
+	// SUBMENU: FrameSkip 
+	subMenu_FrameSkip = gcnew ToolStripMenuItem();
+	subMenu_FrameSkip->Text = "Frame Skip";
+	subMenu_FrameSkip->DropDownItems->Add("Off");
+	subMenu_FrameSkip->DropDownItems->Add("1");
+	subMenu_FrameSkip->DropDownItems->Add("2");
+	subMenu_FrameSkip->DropDownItems->Add("3");
+	subMenu_FrameSkip->DropDownItems->Add("Auto");
+	subMenu_FrameSkip->DropDownItems->Add("No Render");
+	subMenu_FrameSkip->DropDownItemClicked += gcnew System::Windows::Forms::ToolStripItemClickedEventHandler(&subMenu_FrameSkip_ButtonClick);
+
 	// SUBMENU: Palette 
 	subMenu_Palette = gcnew ToolStripMenuItem();
 	subMenu_Palette->Text = "Color Palette";
@@ -951,6 +1033,7 @@ void SetupWinForms()
 	subMenu_Palette->DropDownItems->Add("Commodore 64");
 	subMenu_Palette->DropDownItems->Add("CGA DOS");
 	subMenu_Palette->DropDownItems->Add("EGA DOS");
+	subMenu_Palette->DropDownItems->Add("Custom ( .pal )");
 	subMenu_Palette->DropDownItemClicked += gcnew System::Windows::Forms::ToolStripItemClickedEventHandler(&subMenu_Palette_ButtonClick);
 
 	// SUBMENU: DebugDisplay Options
@@ -970,9 +1053,11 @@ void SetupWinForms()
 	menu_Options->DropDownItems->Add("PatternTable Viewer");
 	menu_Options->DropDownItems->Add("Draw Scanlines");
 	menu_Options->DropDownItems->Add("Allow Non-Integer Scaling");
+	menu_Options->DropDownItems->Add("NTSC Filter");
 	//menu_Options->DropDownItems->Add("Filter Screen"); // Currently Disabled
 	menu_Options->DropDownItems->Add(subMenu_DebugDisplay);
 	menu_Options->DropDownItems->Add(subMenu_DebugSpeed);
+	menu_Options->DropDownItems->Add(subMenu_FrameSkip);
 	menu_Options->DropDownItems->Add(subMenu_Palette);
 	menu_Options->DropDownItemClicked += gcnew System::Windows::Forms::ToolStripItemClickedEventHandler(&menu_Options_ButtonClick);
 
@@ -1003,6 +1088,7 @@ void SetupWinForms()
 	toolStrip->Items->Add("TEST");
 	toolStrip->Items->Add("TEST2");
 	toolStrip->Items->Add("BATCH");
+	toolStrip->Items->Add("THREADS");
 #endif
 
 	// Setup Menu Window
@@ -2,6 +2,7 @@
 
 // Conntendo
 #include "cpu.h"
+#include "console.h"
 
 #define DEFAULT_VOLUME 0.5f
 
@@ -12,24 +13,69 @@ namespace APU
 	const long CPU_CLOCK	= 1789773; // NTSC 1.789773 MHz
 	const size_t OUT_SIZE	= 4096;
 
+	// Host audio device, shared by every Console
+	static Sound_Queue* soundQueue;
+
+	void OutputSamples(const blip_sample_t* samples, size_t count)
+	{
+		soundQueue->write( samples, count);
+
+	} // OutputSamples()
+
+	// Callback Function for playing back samples ( off the CPU of the APU's own Console )
+	int DMCRead( void* cpu, cpu_addr_t address )
+	{
+		return CPU::ReadMemory( (CPU::Core*)cpu, address );
+
+	} // DMCRead()
+
+	void Init()
+	{
+		soundQueue = new Sound_Queue;
+		soundQueue->init(SAMPLE_RATE);
+
+	} // Init()
+
+} // APU
+
+// One Console's APU: Blargg's synthesis and the samples waiting to go out
+class APU::Core
+{
+public:
+
 	// Blargg Audio
 	Blip_Buffer buffer;
 	Nes_Apu blarggAPU;
 	blip_sample_t outBuf[OUT_SIZE];
 
-	double totalCycles;
-	static Sound_Queue* soundQueue;
+	double totalCycles			= 0;
+
+	// Samples are thrown away instead of going out to the Audio device ( see Console::headless )
+	bool headless				= false;
 
 	// Conntendo Settings
 	float gameVolume			= 1;
 	bool  bMuteAudio			= false;
 	bool  muteChannelList[5]	= { 0 };
 
-	void OutputSamples(const blip_sample_t* samples, size_t count)
+	Core()
 	{
-		soundQueue->write( samples, count);
+		buffer.sample_rate(SAMPLE_RATE);
+		buffer.clock_rate(CPU_CLOCK);
 
-	} // OutputSamples()
+		blarggAPU.output(&buffer);
+
+		SetVolume(DEFAULT_VOLUME);
+
+	} // Core()
+
+	void Connect(Console& console)
+	{
+		// Assign DMC Callback
+		blarggAPU.dmc_reader(DMCRead, console.cpu);
+		headless = console.headless;
+
+	} // Connect()
 
 	// Enable or disable Emulator sound
 	bool ToggleMuteAudio()
@@ -78,14 +124,22 @@ namespace APU
 	} // ToggleOneChannel()
 
 	// At end of CPU Frame, run APU
-	void RunFrame(long length )
+	void RunFrame(long length)
 	{
 		blarggAPU.end_frame(length);
 		buffer.end_frame(length);
 		totalCycles -= length;
 
-		// Read samples out of Blip_Buffer if there are enough to fill our output buffer
-		if (buffer.samples_avail() >= OUT_SIZE)
+		// Still synthesized so the DMC keeps reading and timing its IRQs
+		if (headless)
+		{
+			buffer.remove_samples(buffer.samples_avail());
+			return;
+		}
+
+		// Read samples out of Blip_Buffer while there are enough to fill our output buffer
+		// ( a slowed down frame can make more than one buffer's worth )
+		while (buffer.samples_avail() >= OUT_SIZE)
 		{
 			size_t count = buffer.read_samples(outBuf, OUT_SIZE);
 			OutputSamples(outBuf, count);
@@ -93,6 +147,14 @@ namespace APU
 
 	} // RunFrame()
 
+	// Resample every frame the CPU runs to the host's real time, so sped up frames are all
+	// heard squeezed together and slowed down ones stretched out, instead of dropped or gapped
+	void SetSpeed(double speed)
+	{
+		buffer.clock_rate( (long)(CPU_CLOCK * speed) );
+
+	} // SetSpeed()
+
 	u8 write8( long elapsed, u16 address, u8 val )
 	{
 		blarggAPU.write_register( elapsed, address, val );
@@ -107,30 +169,6 @@ namespace APU
 
 	} // read8()
 
-	// Callback Function for playing back samples
-	int DMCRead( void*, cpu_addr_t address )
-	{
-		return CPU::ReadMemory( address );
-
-	} // DMCRead()
-
-	void Init()
-	{
-		soundQueue = new Sound_Queue;
-		soundQueue->init(SAMPLE_RATE);
-
-		buffer.sample_rate(SAMPLE_RATE);
-		buffer.clock_rate(CPU_CLOCK);
-
-		blarggAPU.output(&buffer);
-
-		// Assign DMC Callback
-		blarggAPU.dmc_reader(DMCRead);
-
-		SetVolume(DEFAULT_VOLUME);
-
-	} // Init()
-
 	void Reset()
 	{
 		blarggAPU.reset();
@@ -138,5 +176,27 @@ namespace APU
 
 	} // Reset()
 
-} // APU
+}; // APU::Core
+
+//-------------- Console Wrappers --------------//
 
+namespace APU
+{
+	Core* CreateCore()				{ return new Core(); }
+	void DestroyCore(Core* core)	{ delete core; }
+	void Connect(Core* apu, Console& console)	{ apu->Connect(console); }
+
+	// Straight to the Core ( from the CPU of its Console )
+	u8 write8(Core* apu, long elapsed, u16 address, u8 val)	{ return apu->write8(elapsed, address, val); }
+	u8 read8(Core* apu, long elapsed)						{ return apu->read8(elapsed); }
+	void RunFrame(Core* apu, long length)					{ apu->RunFrame(length); }
+	void SetSpeed(Core* apu, double speed)					{ apu->SetSpeed(speed); }
+
+	// Run on the calling thread's current Console
+	void Reset()									{ Console::Current().apu->Reset(); }
+	bool ToggleMuteAudio()							{ return Console::Current().apu->ToggleMuteAudio(); }
+	bool ToggleOneChannel(int channel)				{ return Console::Current().apu->ToggleOneChannel(channel); }
+	void AdjustVolume(float adjust)					{ Console::Current().apu->AdjustVolume(adjust); }
+	string PrintVolume()							{ return Console::Current().apu->PrintVolume(); }
+
+} // APU
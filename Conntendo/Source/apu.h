@@ -11,20 +11,29 @@
 #include "nes_apu/Nes_Apu.h"
 #include "Sound_Queue.h"
 
+class Console; // console.h
+
 namespace APU
 {
+	// Each Console owns a Core, the functions below taking no Core run on the current one ( see console.h )
+	class Core;
+	Core* CreateCore();
+	void DestroyCore(Core* core);
+	void Connect(Core* apu, Console& console); // the Console's CPU, for DMC reads
+
 	// Blargg Audio
 	void OutputSamples(const blip_sample_t* samples, size_t count);
-	int DMCRead(void*, cpu_addr_t address);
+	int DMCRead(void* cpu, cpu_addr_t address);
 
 	// Read|Write Functions
-	u8 write8( long elapsed, u16 address, u8 val );
-	u8 read8( long elapsed );
+	u8 write8( Core* apu, long elapsed, u16 address, u8 val );
+	u8 read8( Core* apu, long elapsed );
 
 	// Managing APU
 	void Init();
 	void Reset();
-	void RunFrame( long length );
+	void RunFrame( Core* apu, long length );
+	void SetSpeed( Core* apu, double speed ); // Emulation speed, output is resampled to stay real time
 
 	// Emulator Seetings
 	bool ToggleMuteAudio();
@@ -7,6 +7,7 @@
 #include "joypad.h"
 #include "emulator.h"
 #include "files.h"
+#include "console.h"
 
 // Mappers
 #include "mapper0.h"
@@ -27,74 +28,55 @@
 #define EXTRACT_MAPPER		(rom[7] & 0xF0) | (rom[6] >> 4)
 #define IGNORE_MIRRORING	(rom[6] & 0x08)
 
-namespace Cartridge
+// One Console's Cartridge: the loaded game and its Mapper chip
+class Cartridge::Core
 {
+public:
+
 	Mapper* mapper		= nullptr; 
+	MapperCalls calls;	// mapper's own functions, for the CPU and PPU
 	string gameName		= "";
 
-	// Get name of current game loaded
-	string GetGameName()
-	{
-		return gameName;
-
-	} // GetGameName()
-
-	// Return path to Cartridge's Mapper Chip
-	Mapper* GetMapper() 
-	{
-		return mapper;
-
-	} // GetMapper() 
-
-	u8 WritePRG(u16 address, u8 val)
-	{
-		return mapper->write8(address, val);
-
-	} // WritePRG()
-
-	u8 ReadPRG(u16 address)
-	{
-		return mapper->read8(address);
-
-	} // ReadPRG()
+	// Console the Cartridge is plugged into, its Mappers talk to its CPU and PPU ( see Connect )
+	Console* console	= nullptr;
+	CPU::Core* cpu		= nullptr;
+	PPU::Core* ppu		= nullptr;
 
-	u8 WriteCHR(u16 address, u8 val)
+	void Connect(Console& owner)
 	{
-		return mapper->chr_write8(address, val);
+		console	= &owner;
+		cpu		= owner.cpu;
+		ppu		= owner.ppu;
 
-	} // WriteCHR()
+	} // Connect()
 
-	u8 ReadCHR(u16 address)
+	~Core()
 	{
-		return mapper->chr_read8(address);
+		delete mapper;
 
-	} // ReadCHR()
-
-	// For CPU-Counter IRQs 
-	void SignalCPU()
-	{
-		mapper->SignalCPU();
+	} // ~Core()
 
-	} // SignalCPU()	
-	
-	// For Scanline-Counter IRQs
-	void SignalScanline()
+	// Bind the Mapper's calls to its own class
+	template <class MapperType>
+	void UseMapper(MapperType* newMapper)
 	{
-		mapper->SignalScanline();
+		mapper = newMapper;
+		calls.Bind(newMapper);
 
-	} // SignalScanline()
+	} // UseMapper()
 
-	u8 ReadExtraRAM(u16 address)
+	// Get name of current game loaded
+	string GetGameName()
 	{
-		return mapper->ReadExtraRAM(address);
+		return gameName;
 
-	} // ReadExtraRAM()
+	} // GetGameName()
 
-	u8 WriteExtraRAM(u16 address, u8 val)
+	const u8* DecodedCHR(u16 address)
 	{
-		return mapper->WriteExtraRAM(address, val);
+		return mapper ? mapper->chr_decoded(address) : nullptr;
 
-	} // WriteExtraRAM()
+	} // DecodedCHR()
 
 	bool CreateSaveState(int slot)
 	{
@@ -136,7 +118,10 @@ namespace Cartridge
 		u8* rom = Files::ReadROMFile(romPath);
 		if ( rom == nullptr )
 		{
-			Emulator::ShowMessage("Error Grabbing ROM");
+			if (!console->headless)
+			{
+				Emulator::ShowMessage("Error Grabbing ROM");
+			}
 			return false;
 		}
 
@@ -147,63 +132,94 @@ namespace Cartridge
 
 		// Special Case games that use 4K Nametable RAM
 		bool useExtraRAM = IGNORE_MIRRORING;
-		PPU::DisableCIRAM(useExtraRAM);
+		PPU::DisableCIRAM(ppu, useExtraRAM);
 
 		// Cleanup previous Mapper data before loading for new Cartridge
-		if (Emulator::IsLoaded())
+		if (mapper != nullptr)
 		{
+			PPU::SetCHRBanks(ppu, nullptr);
+			PPU::SetNameTableRAM(ppu, nullptr);
+			PPU::SetMapper(ppu, nullptr);
+			CPU::SetMapper(cpu, nullptr);
 			delete mapper;
+			mapper = nullptr;
 		}
 
 		// Instantiate to appropriate Mapper if it exists
 		switch (mapperNum)
 		{
 		case 0: // Stock
-			mapper = new Mapper0(rom); 
+			UseMapper(new Mapper0(rom, *console)); 
 			break;
 		case 1: // MMC1
-			mapper = new Mapper1(rom);
+			UseMapper(new Mapper1(rom, *console));
 			break;
 		case 2: // UxROM
-			mapper = new Mapper2(rom);
+			UseMapper(new Mapper2(rom, *console));
 			break;
 		case 3: // CNROM
-			mapper = new Mapper3(rom);
+			UseMapper(new Mapper3(rom, *console));
 			break;
 		case 4: // MMC3
-			mapper = new Mapper4(rom);
+			UseMapper(new Mapper4(rom, *console));
 			break;
 		case 5: // MMC5
-			mapper = new Mapper5(rom);
+			UseMapper(new Mapper5(rom, *console));
 			break;
 		case 7: // AxROM 
-			mapper = new Mapper7(rom);
+			UseMapper(new Mapper7(rom, *console));
 			break;
 		case 9: // MMC2
-			mapper = new Mapper9(rom);
+			UseMapper(new Mapper9(rom, *console));
 			break;
 		case 10: // MMC4
-			mapper = new Mapper10(rom);
+			UseMapper(new Mapper10(rom, *console));
 			break;
 		case 11: // Color Dreams
-			mapper = new Mapper11(rom); 
+			UseMapper(new Mapper11(rom, *console)); 
 			break;
 		case 25: // VRC4 (Work-in-Progress)
-			mapper = new Mapper25(rom);
+			UseMapper(new Mapper25(rom, *console));
 			break;
 		case 66: // GxROM
-			mapper = new Mapper66(rom);
+			UseMapper(new Mapper66(rom, *console));
 			break;
 		case 69: // Sunsoft FME-7
-			mapper = new Mapper69(rom);
+			UseMapper(new Mapper69(rom, *console));
 			break;
-		default: // Mapper does not exist yet
+		default: // Mapper does not exist yet ( no Mapper owns the ROM, so it's freed here )
+			delete[] rom;
 			return false;
 		}
+
+		// PPU reads CHR and Nametables straight from the Mapper's banks unless they switch on reads
+		PPU::SetCHRBanks(ppu, mapper->chr_banks());
+		PPU::SetNameTableRAM(ppu, mapper->nt_banks());
+
+		// CPU and PPU call the Mapper directly, and only send the signals it asked for
+		PPU::SetMapper(ppu, &calls);
+		CPU::SetMapper(cpu, &calls);
 		
 		// ROM Successfully Loaded
 		return true;
 
 	} // LoadROM()
 
+}; // Cartridge::Core
+
+//-------------- Console Wrappers --------------//
+
+namespace Cartridge
+{
+	Core* CreateCore()				{ return new Core(); }
+	void DestroyCore(Core* core)	{ delete core; }
+	void Connect(Core* cartridge, Console& console)	{ cartridge->Connect(console); }
+
+	// Run on the calling thread's current Console
+	string GetGameName()						{ return Console::Current().cartridge->GetGameName(); }
+	bool LoadROM(const char* romPath)			{ return Console::Current().cartridge->LoadROM(romPath); }
+	bool CreateSaveState(int slot)				{ return Console::Current().cartridge->CreateSaveState(slot); }
+	bool LoadSaveState(int slot)				{ return Console::Current().cartridge->LoadSaveState(slot); }
+	const u8* DecodedCHR(u16 address)			{ return Console::Current().cartridge->DecodedCHR(address); }
+
 } // Cartridge
\ No newline at end of file
@@ -7,8 +7,16 @@
 #include "common.h"
 #include "mapper.h"
 
+class Console; // console.h
+
 namespace Cartridge 
 {
+	// Each Console owns a Core, the functions below taking no Core run on the current one ( see console.h )
+	class Core;
+	Core* CreateCore();
+	void DestroyCore(Core* core);
+	void Connect(Core* cartridge, Console& console); // the Console's CPU and PPU, for its Mappers
+
 	// ROM Grabbing Functions
 	string GetGameName();
 	bool LoadROM(const char* romName);
@@ -17,19 +25,8 @@ namespace Cartridge
 	bool CreateSaveState(int slot);
 	bool LoadSaveState(int slot);
 
-	// ROM Read-Write Functions
-	u8 WriteCHR(u16 address, u8 val);
-	u8 ReadCHR(u16 address);
-	u8 WritePRG(u16 address, u8 val);
-	u8 ReadPRG(u16 address);
-
-	// Mapper Functions
-	void SignalScanline();
-	void SignalCPU();
-	Mapper* GetMapper();
-
-	// Extra Cartridge vRAM ( Gauntlet, Rad Racer II etc )
-	u8 ReadExtraRAM(u16 address);
-	u8 WriteExtraRAM(u16 address, u8 val);
+	// Pattern row as 8 palette indices, nullptr if unavailable ( for the Pattern Table Viewer,
+	// the CPU and PPU call the Mapper directly )
+	const u8* DecodedCHR(u16 address);
 
 } // Cartridge
@@ -40,6 +40,7 @@ using namespace std;
 #define DEV_BUILD 0
 #define USE_COMPRESSION 1
 #define DEBUG_DUMP_OPCODES 0
+#define DEBUG_COMPARE_BACKENDS 0
 
 // KB Values
 const int K_1		= 1024;		// 0x0400
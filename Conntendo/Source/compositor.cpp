@@ -0,0 +1,343 @@
+#include "compositor.h"
+
+#include <cmath>
+
+// SIMD kernels only on x86 / x64, everything else runs the Scalar ones
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+	#define COMPOSITOR_X86
+	#include <immintrin.h>
+	#ifdef _MSC_VER
+		#include <intrin.h>
+		#define TARGET_SSE2
+		#define TARGET_AVX2
+	#else
+		#define TARGET_SSE2 __attribute__((target("sse2")))
+		#define TARGET_AVX2 __attribute__((target("avx2")))
+	#endif
+#endif
+
+namespace Compositor
+{
+	//-------------- Scalar --------------//
+
+	void ExpandPlanesScalar(u8* pixels, u8 low, u8 high, u8 attr)
+	{
+		for (int i = 0; i < 8; i++)
+		{
+			u8 palette = (NTH_BIT(high, 7 - i) << 1) | NTH_BIT(low, 7 - i);
+			pixels[i] = palette ? (palette | (attr << 2)) : 0;
+		} // for
+
+	} // ExpandPlanesScalar()
+
+	bool MergeLineScalar(u8* palettes, const u8* background, const u8* sprites, int count)
+	{
+		bool hit = false;
+		for (int i = 0; i < count; i++)
+		{
+			u8 bgPalette	= background[i];
+			u8 sprite		= sprites[i];
+			u8 objPalette	= sprite & SPRITE_PIXEL_PALETTE;
+
+			hit |= (sprite & SPRITE_PIXEL_ZERO) && bgPalette;
+			palettes[i] = ( objPalette && (bgPalette == 0 || !(sprite & SPRITE_PIXEL_BEHIND)) ) ? objPalette : bgPalette;
+		} // for
+		return hit;
+
+	} // MergeLineScalar()
+
+	void ColorLineScalar(u16* pixels, const u8* palettes, const u16* colors, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			pixels[i] = colors[palettes[i]];
+		} // for
+
+	} // ColorLineScalar()
+
+	void LookupLineScalar(u32* colors, const u16* pixels, const u32* table, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			colors[i] = table[pixels[i]];
+		} // for
+
+	} // LookupLineScalar()
+
+	// Edge pixels stand in for their missing neighbours
+	inline void NTSCNeighbours(const u16* pixels, const float* table, int phase, int i, int count, const float** parts)
+	{
+		int prev	= (i > 0) ? (i - 1) : i;
+		int next	= (i < count - 1) ? (i + 1) : i;
+		parts[0]	= NTSC_ENTRY(table, pixels[prev], (phase + (prev * 8)) % NTSC_PHASES, NTSC_TAIL);
+		parts[1]	= NTSC_ENTRY(table, pixels[i], (phase + (i * 8)) % NTSC_PHASES, NTSC_BODY);
+		parts[2]	= NTSC_ENTRY(table, pixels[next], (phase + (next * 8)) % NTSC_PHASES, NTSC_HEAD);
+
+	} // NTSCNeighbours()
+
+	void NTSCLineScalar(u32* colors, const u16* pixels, const float* table, int phase, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			const float* parts[3];
+			NTSCNeighbours(pixels, table, phase, i, count, parts);
+
+			u32 color = 0;
+			for (int channel = 0; channel < 3; channel++)
+			{
+				long level = lrintf(parts[0][channel] + parts[1][channel] + parts[2][channel]);
+				level = (level < 0) ? 0 : (level > 0xFF) ? 0xFF : level;
+				color |= level << (channel * 8);
+			} // for
+			colors[i] = color;
+		} // for
+
+	} // NTSCLineScalar()
+
+#ifdef COMPOSITOR_X86
+
+	//-------------- SSE2 --------------//
+
+	TARGET_SSE2 void ExpandPlanesSSE2(u8* pixels, u8 low, u8 high, u8 attr)
+	{
+		const __m128i bits = _mm_setr_epi8(	(char)0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+											(char)0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01 );
+
+		// Every lane picks out its own bit of each plane
+		__m128i lowSet	= _mm_cmpeq_epi8(_mm_and_si128(_mm_set1_epi8((char)low), bits), bits);
+		__m128i highSet = _mm_cmpeq_epi8(_mm_and_si128(_mm_set1_epi8((char)high), bits), bits);
+		__m128i palette = _mm_or_si128(_mm_and_si128(lowSet, _mm_set1_epi8(1)), _mm_and_si128(highSet, _mm_set1_epi8(2)));
+		__m128i opaque	= _mm_or_si128(lowSet, highSet);
+		palette			= _mm_or_si128(palette, _mm_and_si128(opaque, _mm_set1_epi8((char)(attr << 2))));
+		_mm_storel_epi64((__m128i*)pixels, palette);
+
+	} // ExpandPlanesSSE2()
+
+	TARGET_SSE2 bool MergeLineSSE2(u8* palettes, const u8* background, const u8* sprites, int count)
+	{
+		const __m128i zero			= _mm_setzero_si128();
+		const __m128i paletteBits	= _mm_set1_epi8(SPRITE_PIXEL_PALETTE);
+		const __m128i behindBit		= _mm_set1_epi8(SPRITE_PIXEL_BEHIND);
+		const __m128i zeroBit		= _mm_set1_epi8(SPRITE_PIXEL_ZERO);
+
+		int hit = 0;
+		int i	= 0;
+		for (; i + 16 <= count; i += 16)
+		{
+			__m128i bgPalette	= _mm_loadu_si128((const __m128i*)(background + i));
+			__m128i sprite		= _mm_loadu_si128((const __m128i*)(sprites + i));
+			__m128i objPalette	= _mm_and_si128(sprite, paletteBits);
+			__m128i bgClear		= _mm_cmpeq_epi8(bgPalette, zero);
+			__m128i objClear	= _mm_cmpeq_epi8(objPalette, zero);
+			__m128i behind		= _mm_cmpeq_epi8(_mm_and_si128(sprite, behindBit), behindBit);
+			__m128i spriteZero	= _mm_cmpeq_epi8(_mm_and_si128(sprite, zeroBit), zeroBit);
+			hit |= _mm_movemask_epi8(_mm_andnot_si128(bgClear, spriteZero));
+
+			// Background shows where the Sprite is clear, or behind an opaque Background pixel
+			__m128i showBG		= _mm_or_si128(objClear, _mm_andnot_si128(bgClear, behind));
+			__m128i palette		= _mm_or_si128(_mm_and_si128(showBG, bgPalette), _mm_andnot_si128(showBG, objPalette));
+			_mm_storeu_si128((__m128i*)(palettes + i), palette);
+		} // for
+		return MergeLineScalar(palettes + i, background + i, sprites + i, count - i) || hit;
+
+	} // MergeLineSSE2()
+
+	// One pixel per vector: Blue, Green, Red and a zero lane, saturated down to bytes
+	TARGET_SSE2 void NTSCLineSSE2(u32* colors, const u16* pixels, const float* table, int phase, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			const float* parts[3];
+			NTSCNeighbours(pixels, table, phase, i, count, parts);
+
+			__m128 level	= _mm_add_ps(_mm_add_ps(_mm_loadu_ps(parts[0]), _mm_loadu_ps(parts[1])), _mm_loadu_ps(parts[2]));
+			__m128i color	= _mm_cvtps_epi32(level);
+			color			= _mm_packs_epi32(color, color);
+			color			= _mm_packus_epi16(color, color);
+			colors[i]		= _mm_cvtsi128_si32(color);
+		} // for
+
+	} // NTSCLineSSE2()
+
+	//-------------- AVX2 --------------//
+
+	TARGET_AVX2 bool MergeLineAVX2(u8* palettes, const u8* background, const u8* sprites, int count)
+	{
+		const __m256i zero			= _mm256_setzero_si256();
+		const __m256i paletteBits	= _mm256_set1_epi8(SPRITE_PIXEL_PALETTE);
+		const __m256i behindBit		= _mm256_set1_epi8(SPRITE_PIXEL_BEHIND);
+		const __m256i zeroBit		= _mm256_set1_epi8(SPRITE_PIXEL_ZERO);
+
+		int hit = 0;
+		int i	= 0;
+		for (; i + 32 <= count; i += 32)
+		{
+			__m256i bgPalette	= _mm256_loadu_si256((const __m256i*)(background + i));
+			__m256i sprite		= _mm256_loadu_si256((const __m256i*)(sprites + i));
+			__m256i objPalette	= _mm256_and_si256(sprite, paletteBits);
+			__m256i bgClear		= _mm256_cmpeq_epi8(bgPalette, zero);
+			__m256i objClear	= _mm256_cmpeq_epi8(objPalette, zero);
+			__m256i behind		= _mm256_cmpeq_epi8(_mm256_and_si256(sprite, behindBit), behindBit);
+			__m256i spriteZero	= _mm256_cmpeq_epi8(_mm256_and_si256(sprite, zeroBit), zeroBit);
+			hit |= _mm256_movemask_epi8(_mm256_andnot_si256(bgClear, spriteZero));
+
+			__m256i showBG		= _mm256_or_si256(objClear, _mm256_andnot_si256(bgClear, behind));
+			__m256i palette		= _mm256_or_si256(_mm256_and_si256(showBG, bgPalette), _mm256_andnot_si256(showBG, objPalette));
+			_mm256_storeu_si256((__m256i*)(palettes + i), palette);
+		} // for
+		return MergeLineSSE2(palettes + i, background + i, sprites + i, count - i) || hit;
+
+	} // MergeLineAVX2()
+
+	// 16 colour indices per pair of gathers ( SSE2 has no gather, so it stays on the Scalar loop )
+	TARGET_AVX2 void ColorLineAVX2(u16* pixels, const u8* palettes, const u16* colors, int count)
+	{
+		const __m256i lowHalf = _mm256_set1_epi32(0xFFFF);
+
+		int i = 0;
+		for (; i + 16 <= count; i += 16)
+		{
+			// 32 bits gathered at each 16 bit entry, the low half is the entry ( why the table is padded )
+			__m256i indexA	= _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(palettes + i)));
+			__m256i indexB	= _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(palettes + i + 8)));
+			__m256i colorA	= _mm256_and_si256(_mm256_i32gather_epi32((const int*)colors, indexA, 2), lowHalf);
+			__m256i colorB	= _mm256_and_si256(_mm256_i32gather_epi32((const int*)colors, indexB, 2), lowHalf);
+
+			// Packing works per 128 bit lane, put the quarters back in order
+			__m256i packed	= _mm256_permute4x64_epi64(_mm256_packus_epi32(colorA, colorB), 0xD8);
+			_mm256_storeu_si256((__m256i*)(pixels + i), packed);
+		} // for
+		ColorLineScalar(pixels + i, palettes + i, colors, count - i);
+
+	} // ColorLineAVX2()
+
+	TARGET_AVX2 void LookupLineAVX2(u32* colors, const u16* pixels, const u32* table, int count)
+	{
+		int i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256i index = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(pixels + i)));
+			__m256i color = _mm256_i32gather_epi32((const int*)table, index, 4);
+			_mm256_storeu_si256((__m256i*)(colors + i), color);
+		} // for
+		LookupLineScalar(colors + i, pixels + i, table, count - i);
+
+	} // LookupLineAVX2()
+
+#endif // COMPOSITOR_X86
+
+	//-------------- Dispatch --------------//
+
+	// Best Kernel the CPU ( and OS, for the AVX registers ) supports
+	Kernel DetectKernel()
+	{
+#ifdef COMPOSITOR_X86
+	#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 1);
+		bool hasSSE2	= (info[3] >> 26) & 1;
+		bool hasAVX		= ((info[2] >> 27) & 1) && ((info[2] >> 28) & 1) && ((_xgetbv(0) & 0x06) == 0x06);
+		__cpuidex(info, 7, 0);
+		bool hasAVX2	= hasAVX && ((info[1] >> 5) & 1);
+	#else
+		bool hasSSE2	= __builtin_cpu_supports("sse2");
+		bool hasAVX2	= __builtin_cpu_supports("avx2");
+	#endif
+		if (hasAVX2)
+		{
+			return Kernel::AVX2;
+		}
+		if (hasSSE2)
+		{
+			return Kernel::SSE2;
+		}
+#endif
+		return Kernel::Scalar;
+
+	} // DetectKernel()
+
+	const Kernel bestKernel = DetectKernel();
+	Kernel kernel			= bestKernel;
+
+	Kernel GetKernel()
+	{
+		return kernel;
+
+	} // GetKernel()
+
+	Kernel UseKernel(Kernel toUse)
+	{
+		kernel = (toUse < bestKernel) ? toUse : bestKernel;
+		return kernel;
+
+	} // UseKernel()
+
+	void ExpandPlanes(u8* pixels, u8 low, u8 high, u8 attr)
+	{
+#ifdef COMPOSITOR_X86
+		if (kernel != Kernel::Scalar)
+		{
+			ExpandPlanesSSE2(pixels, low, high, attr); // 8 pixels fill an SSE2 half already
+			return;
+		}
+#endif
+		ExpandPlanesScalar(pixels, low, high, attr);
+
+	} // ExpandPlanes()
+
+	bool MergeLine(u8* palettes, const u8* background, const u8* sprites, int count)
+	{
+		switch (kernel)
+		{
+#ifdef COMPOSITOR_X86
+		case Kernel::AVX2:
+			return MergeLineAVX2(palettes, background, sprites, count);
+		case Kernel::SSE2:
+			return MergeLineSSE2(palettes, background, sprites, count);
+#endif
+		default:
+			return MergeLineScalar(palettes, background, sprites, count);
+		} // switch
+
+	} // MergeLine()
+
+	void ColorLine(u16* pixels, const u8* palettes, const u16* colors, int count)
+	{
+#ifdef COMPOSITOR_X86
+		if (kernel == Kernel::AVX2)
+		{
+			ColorLineAVX2(pixels, palettes, colors, count);
+			return;
+		}
+#endif
+		ColorLineScalar(pixels, palettes, colors, count);
+
+	} // ColorLine()
+
+	void LookupLine(u32* colors, const u16* pixels, const u32* table, int count)
+	{
+#ifdef COMPOSITOR_X86
+		if (kernel == Kernel::AVX2)
+		{
+			LookupLineAVX2(colors, pixels, table, count);
+			return;
+		}
+#endif
+		LookupLineScalar(colors, pixels, table, count);
+
+	} // LookupLine()
+
+	void NTSCLine(u32* colors, const u16* pixels, const float* table, int phase, int count)
+	{
+#ifdef COMPOSITOR_X86
+		if (kernel != Kernel::Scalar)
+		{
+			NTSCLineSSE2(colors, pixels, table, phase, count); // a pixel's 3 channels fit one SSE register
+			return;
+		}
+#endif
+		NTSCLineScalar(colors, pixels, table, phase, count);
+
+	} // NTSCLine()
+
+} // Compositor
@@ -0,0 +1,51 @@
+#pragma once
+//----------------------------------------------------------------//
+// Scanline Pixel Kernels: bit planes to palettes, Background and
+// Sprite merging, palettes to colour indices, colour indices to ARGB
+// ( SSE2 / AVX2 when the CPU has them )
+//----------------------------------------------------------------//
+
+#include "common.h"
+
+// Sprite Line Pixel Bits
+#define SPRITE_PIXEL_PALETTE	0x1F	// Front-most opaque Sprite palette ( 0x10-0x1F ), 0 if none
+#define SPRITE_PIXEL_BEHIND		0x20	// Front-most opaque Sprite is behind the Background
+#define SPRITE_PIXEL_ZERO		0x40	// Sprite 0 is opaque here ( and can hit )
+#define SPRITE_PIXEL_ALPHA		0x80	// a Sprite has a transparent pixel here ( for Debug Fill )
+
+// NTSC Filter Table: 4 floats ( Blue, Green, Red, 0 ) for each colour index, subcarrier phase and part,
+// a pixel's output is the previous pixel's tail + its own body + the next pixel's head
+#define NTSC_PHASES		12
+#define NTSC_PARTS		3
+#define NTSC_TAIL		0
+#define NTSC_BODY		1
+#define NTSC_HEAD		2
+#define NTSC_ENTRY(table, index, phase, part) ( (table) + ((((index) * NTSC_PHASES + (phase)) * NTSC_PARTS) + (part)) * 4 )
+
+namespace Compositor
+{
+	enum Kernel
+	{
+		Scalar,
+		SSE2,
+		AVX2
+	};
+
+	// Kernel Selection ( picks the best the CPU supports on startup )
+	Kernel GetKernel();
+	Kernel UseKernel(Kernel kernel); // falls back to the best supported one below it
+
+	// 8 pixels of a tile row from its two bit planes, attribute bits on the opaque ones
+	void ExpandPlanes(u8* pixels, u8 low, u8 high, u8 attr);
+
+	// Background palettes merged with the Sprite line by priority, returns true on a Sprite 0 hit
+	bool MergeLine(u8* palettes, const u8* background, const u8* sprites, int count);
+
+	// Palettes to colour indices through a 32 entry table ( padded to 33 for the AVX2 gather )
+	void ColorLine(u16* pixels, const u8* palettes, const u16* colors, int count);
+
+	// Colour indices to ARGB, straight through a table or through the NTSC Filter Table
+	void LookupLine(u32* colors, const u16* pixels, const u32* table, int count);
+	void NTSCLine(u32* colors, const u16* pixels, const float* table, int phase, int count);
+
+} // Compositor
@@ -0,0 +1,65 @@
+#include "console.h"
+
+// Conntendo
+#include "cpu.h"
+#include "ppu.h"
+#include "apu.h"
+#include "joypad.h"
+#include "cartridge.h"
+
+// Console this thread runs on, nullptr falls back to the Default Console
+// ( /clr has no thread_local, this file is built as native code, see Conntendo.vcxproj )
+static thread_local Console* currentConsole = nullptr;
+
+// Constructor
+Console::Console(bool isHeadless) : headless(isHeadless)
+{
+	cpu			= CPU::CreateCore();
+	ppu			= PPU::CreateCore();
+	apu			= APU::CreateCore();
+	joypad		= Joypad::CreateCore();
+	cartridge	= Cartridge::CreateCore();
+
+	// Each Core keeps pointers to the others it calls
+	CPU::Connect(cpu, *this);
+	PPU::Connect(ppu, *this);
+	APU::Connect(apu, *this);
+	Cartridge::Connect(cartridge, *this);
+
+} // Console()
+
+// Destructor
+Console::~Console()
+{
+	if (currentConsole == this)
+	{
+		currentConsole = nullptr;
+	}
+
+	// Reverse order of construction
+	Cartridge::DestroyCore(cartridge);
+	Joypad::DestroyCore(joypad);
+	APU::DestroyCore(apu);
+	PPU::DestroyCore(ppu);
+	CPU::DestroyCore(cpu);
+
+} // ~Console()
+
+void Console::MakeCurrent()
+{
+	currentConsole = this;
+
+} // MakeCurrent()
+
+Console& Console::Current()
+{
+	return currentConsole ? *currentConsole : Default();
+
+} // Current()
+
+Console& Console::Default()
+{
+	static Console defaultConsole(false);
+	return defaultConsole;
+
+} // Default()
@@ -0,0 +1,51 @@
+#pragma once
+//----------------------------------------------------------------//
+// A whole NES: CPU, PPU, APU, controller ports and Cartridge
+// The Cores are connected to each other when the Console is made and call each other directly.
+// Module functions ( CPU::RunFrame, PPU::Reset... ) are for the frontend, and run on the calling
+// thread's current Console, so each thread can run its own game ( every Console but the Default is headless )
+//----------------------------------------------------------------//
+
+// Conntendo
+#include "common.h"
+
+// Hardware owned by a Console ( defined in each module )
+namespace CPU		{ class Core; }
+namespace PPU		{ class Core; }
+namespace APU		{ class Core; }
+namespace Joypad	{ class Core; }
+namespace Cartridge	{ class Core; }
+
+class Console
+{
+public:
+
+	explicit Console(bool isHeadless = true);
+	~Console();
+
+	// Only the Default Console goes out to the Screen and Audio device, the rest keep their frames and samples to themselves
+	const bool headless;
+
+	// Hardware
+	CPU::Core*			cpu;
+	PPU::Core*			ppu;
+	APU::Core*			apu;
+	Joypad::Core*		joypad;
+	Cartridge::Core*	cartridge;
+
+	// Run this thread's module functions on this Console
+	void MakeCurrent();
+
+	// Console the module functions run on ( Default unless the thread made another one current )
+	static Console& Current();
+
+	// Console played by the Emulator frontend
+	static Console& Default();
+
+private:
+
+	// One owner per piece of hardware
+	Console(const Console&);
+	Console& operator=(const Console&);
+
+}; // Console
@@ -7,9 +7,12 @@
 #include "joypad.h"
 #include "emulator.h"
 #include "dev.h"
+#include "console.h"
 
 // STL
 #include <sstream>
+#include <utility>
+#include <climits>
 
 // Addresses
 #define PPUOAMDATA			0x2014
@@ -18,19 +21,49 @@
 #define JOYPAD0				0x4016
 #define JOYPAD1_APU_COUNTER 0x4017
 
-namespace CPU
+// Block Backend
+#define BLOCK_MAX_OPS		32 // longest straight run of instructions recorded as one Block
+#define IDLE_LOOP_MAX_OPS	4  // longest block checked for being an idle loop
+
+// One Console's CPU: registers, RAM, Page Table, Master Clock and Decoded Instruction Cache
+class CPU::Core
 {
+public:
+
 	// Consts
-	const double TOTAL_CYCLES = 29781; // CPU Frame Timing
+	static const int TOTAL_CYCLES = 29781; // CPU Frame Timing
 
 	// CPU Cycles
-	int		cpuCycle	= 0;	// Number of times CPU has been called 
-	int		waitCycles	= 0;	// the number of CPU frames to stall while PPU Ticks
-	double	timingCycle;		// For timing CPU Frame
+	int		cpuCycle	= 0;	// Number of CPU cycles run
+	int		timingCycle;		// Cycle budget for the CPU Frame ( overshoot carries into the next )
+
+	// Master Clock ( PPU runs lazily, only caught up to the CPU when something can observe it )
+	int		frameCycle		= 0;	// CPU cycles run this frame
+	int		ppuSynced		= 0;	// CPU cycle the PPU has been caught up to this frame
+	int		mapperSynced	= 0;	// CPU cycle CPU-Counter Mappers have been clocked up to this frame
+	int		nextPPUEvent	= 0;	// CPU cycle the PPU must be caught up by ( VBlank/NMI, Scanline IRQ )
+	int		nextMapperEvent	= 0;	// CPU cycle CPU-Counter Mappers must be clocked by ( their IRQ ), INT_MAX if never
+	int		opCycle			= 0;	// CPU cycle the running instruction started on
+	bool	mapperClocked	= false; // Mapper subscribed to MAPPER_HOOK_CPU
+	const MapperCalls* mapper = nullptr; // loaded Mapper, called without going through the Cartridge
 	int GetCycle() { return cpuCycle; }
 
+	// Rest of the Console, called directly ( see Connect )
+	PPU::Core*		ppu		= nullptr;
+	APU::Core*		apu		= nullptr;
+	Joypad::Core*	joypad	= nullptr;
+
+	void Connect(Console& console)
+	{
+		ppu		= console.ppu;
+		apu		= console.apu;
+		joypad	= console.joypad;
+
+	} // Connect()
+
 	// CPU Tweaks
-	double emulatorSpeed = 1.0f;
+	double emulatorSpeed	= 1.0f;
+	double framePacer		= 0;	// NES frames owed to the host, speed adds to it once per host frame
 
 #if DEBUG_DUMP_OPCODES
 	// Debug Printing
@@ -47,6 +80,18 @@ namespace CPU
 	u8 SP;				// Stack Pointer
 	ProcessorFlag PF;
 
+	// CPU Page Table
+	u8* readPages[256];
+	u8* writePages[256];
+
+	// Cartridge PRG ROM ( Decoded Instruction Cache is keyed by offsets into it )
+	u8* prgROM			= nullptr;
+	u32 prgROMSize		= 0;
+	u8* fetchOperand	= nullptr;	// operand bytes of the decoded instruction running, nullptr fetches off the bus
+	bool busWritten		= false;	// a write went out to the Memory Map handlers ( PPU, APU/IO, Cartridge )
+	int  busReads		= 0;		// reads that went out to the Memory Map handlers
+	u16  lastBusRead	= 0;
+
 	// Interupt Flags
 	bool nmiFlag;
 	bool irqFlag;
@@ -62,30 +107,87 @@ namespace CPU
 	// Return current cpu timing
 	inline long elapsed() 
 	{ 
-		return TOTAL_CYCLES - timingCycle; 
+		return frameCycle; 
 
 	} // elapsed()
 
 // Fetch Parameter ( based on AddressMode ) Macro
-#define FETCH_PARAMS u16 addr = AddrMode(); u8 val = read8(addr)
-#define PPU_EXECUTE PPU::Execute(); PPU::Execute(); PPU::Execute()
+#define FETCH_PARAMS u16 addr = (this->*AddrMode)(); u8 val = read8(addr)
 #define TICK	Tick()
 #define TICK_2	Tick(); Tick()
 #define TICK_3	Tick(); Tick(); Tick()
 
+//-------------- Master Clock -------------- //
+
+	// Find the CPU cycle the PPU has to be caught up by ( 3 PPU dots per CPU cycle, rounded down to stay early )
+	void ScheduleNextPPUEvent()
+	{
+		nextPPUEvent = ppuSynced + (PPU::DotsToNextEvent(ppu) / 3);
+
+	} // ScheduleNextPPUEvent()
+
+	// Run the PPU up to the given CPU cycle of this frame
+	void SyncPPU(int toCycle)
+	{
+		if (ppuSynced >= toCycle)
+		{
+			return;
+		}
+		PPU::Run(ppu, (toCycle - ppuSynced) * 3); // 3 PPU dots per CPU cycle
+		ppuSynced = toCycle;
+		ScheduleNextPPUEvent();
+
+	} // SyncPPU()
+
+	// Clock CPU-Counter Mappers up to the given CPU cycle of this frame, and find when they are next due
+	void ClockMapper(int toCycle)
+	{
+		int toEvent		= mapper->ClockCPU(mapper->mapper, toCycle - mapperSynced);
+		mapperSynced	= toCycle;
+		nextMapperEvent	= (toEvent == MAPPER_NO_EVENT) ? INT_MAX : toCycle + toEvent;
+
+	} // ClockMapper()
+
+	// Between instructions, only clock the Mapper once its IRQ is due ( it lands between the same two instructions )
+	inline void SyncMapper()
+	{
+		if (frameCycle >= nextMapperEvent)
+		{
+			ClockMapper(frameCycle);
+		}
+
+	} // SyncMapper()
+
+	// Mapper registers see the counter as it was when the instruction started
+	inline void CatchUpMapper()
+	{
+		if (mapperClocked && opCycle > mapperSynced)
+		{
+			ClockMapper(opCycle);
+		}
+
+	} // CatchUpMapper()
+
+	void SetMapper(const MapperCalls* calls)
+	{
+		mapper			= calls;
+		mapperClocked	= calls && (calls->hooks & MAPPER_HOOK_CPU);
+		nextMapperEvent	= mapperClocked ? mapperSynced : INT_MAX;
+
+	} // SetMapper()
+
 //-------------- Debug Print Macros -------------- //
 
 #if DEBUG_DUMP_OPCODES
-#define PFHexPrint ( (int)PF[_NEGATIVE] << 7 ) + ( (int)PF[_OVER_FLOW] << 6 ) + ( 1 << 5 ) + ( 0 << 4 ) + \
-	( (int)PF[_DECIMAL_MODE] << 3 ) + ( (int)PF[_INTERUPT_DISABLE] << 2 ) + ( (int)PF[_ZERO] << 1 ) + ( (int)PF[_CARRY] << 0 )
-#define PFPrint  (bool)PF[_NEGATIVE] << (bool)PF[_OVER_FLOW] << "1" << (bool)PF[_BREAK_COMMAND] << "  " << (bool)PF[_DECIMAL_MODE] << (bool)PF[_INTERUPT_DISABLE] << (bool)PF[_ZERO] << (bool)PF[_CARRY]
+#define PFHexPrint (int)PF.get()
+#define PFPrint  PF.Negative() << (bool)PF[_OVER_FLOW] << "1" << (bool)PF[_BREAK_COMMAND] << "  " << (bool)PF[_DECIMAL_MODE] << (bool)PF[_INTERUPT_DISABLE] << PF.Zero() << (bool)PF[_CARRY]
 
 #define DebugPrint(opCodeName) string opCodeMessage = (debugPrintOpCode) ? "\t" + debugOpCodeResult + "\n" : debugOpCodeResult; \
 	debugStream << opCodeMessage \
 	<< "0x" << std::hex << std::uppercase << std::setw(4) << PC - 1 << "\t" << opCodeName << "\t" \
 	<< std::setfill('0') << std::uppercase << std::hex \
 	<< " A: " << std::setw(2) << (int)A << " X: " << std::setw(2) << (int)X << " Y: " << std::setw(2) << (int)Y \
-	<< " PF: " << PFHexPrint << " SP: " << (int)SP << std::dec << " CYC: " << std::setw(3) << PPU::GetCycle()-3 << " SCN: " << std::setw(3) << PPU::GetScanline(); \
+	<< " PF: " << PFHexPrint << " SP: " << (int)SP << std::dec << " CYC: " << std::setw(3) << PPU::GetCycle(ppu)-3 << " SCN: " << std::setw(3) << PPU::GetScanline(ppu); \
 	debugPrintOpCode = false; \
 	debugOpCodeResult = "\n"
 
@@ -117,6 +219,7 @@ namespace CPU
 	void AdjustSpeed(double newSpeed)
 	{
 		emulatorSpeed = newSpeed;
+		APU::SetSpeed(apu, newSpeed);
 		string speedMessage = "SPEED: x" + to_string(newSpeed);
 		speedMessage.erase(speedMessage.find('.') + 3, std::string::npos);
 		Emulator::ShowMessage(speedMessage);
@@ -126,10 +229,14 @@ namespace CPU
 	//-------------- SaveState -------------- //
 	CPU::SaveData GrabSaveData()
 	{
-		CPU::SaveData savedData(ram, A, X, Y, SP, PC, PF);
-		savedData.SetCPUData(cpuCycle, waitCycles, timingCycle, nmiFlag, irqFlag, nmiCycled, irqCycled);
-		savedData.SetPPUData( PPU::GrabSaveData() );
-		savedData.SetMapperData( Cartridge::GetMapper()->GrabSaveData() );
+		CPU::SaveData savedData(ram, A, X, Y, SP, PC, PF.get());
+		savedData.SetCPUData(cpuCycle, timingCycle, nmiFlag, irqFlag, nmiCycled, irqCycled);
+		savedData.SetPPUData( PPU::GrabSaveData(ppu) );
+		if (mapperClocked)
+		{
+			ClockMapper(frameCycle);
+		}
+		savedData.SetMapperData( mapper->mapper->GrabSaveData() );
 		return savedData;
 
 	} // GrabSaveData()
@@ -142,10 +249,9 @@ namespace CPU
 		Y = saveData.Y;
 		SP = saveData.SP;
 		PC = saveData.PC;
-		PF = saveData.PF;
+		PF.set(saveData.P);
 
 		cpuCycle = saveData.cpuCycle;
-		waitCycles = saveData.waitCycles;
 		timingCycle = saveData.timingCycle;
 		memcpy(ram, saveData.ram, K_2);
 
@@ -155,8 +261,15 @@ namespace CPU
 		irqCycled = saveData.irqCycled;
 
 		// Load PPU and Mapper Data
-		Cartridge::GetMapper()->LoadSaveData(saveData.mapperData);
-		PPU::LoadSaveData(saveData.ppuData);
+		mapper->mapper->LoadSaveData(saveData.mapperData);
+		PPU::LoadSaveData(ppu, saveData.ppuData);
+
+		// PPU is already in step with the CPU
+		frameCycle		= 0;
+		ppuSynced		= 0;
+		mapperSynced	= 0;
+		nextMapperEvent	= mapperClocked ? 0 : INT_MAX;
+		ScheduleNextPPUEvent();
 
 	} // LoadSaveData()
 
@@ -183,6 +296,19 @@ namespace CPU
 
 	} // GetMapLoc()
 
+	// Point a range of CPU pages at memory ( or back to the Memory Map handlers with nullptr )
+	void MapPages(u16 address, int size, u8* readMem, u8* writeMem)
+	{
+		for (int i = 0; i < (size / 0x100); i++)
+		{
+			u8 page = (address >> 8) + i;
+			readPages[page]		= readMem	? readMem + (i * 0x100)	: nullptr;
+			writePages[page]	= writeMem	? writeMem + (i * 0x100)	: nullptr;
+
+		} // for
+
+	} // MapPages()
+
 	//-------------- Read/Write Functions --------------//
 
 	// write to 8-bit address
@@ -202,6 +328,27 @@ namespace CPU
 
 	} // read8()
 
+	// read the next instruction byte, straight out of the decoded instruction when there is one
+	inline u8 fetch8()
+	{
+		TICK;
+		if (fetchOperand)
+		{
+			PC++;
+			return *fetchOperand++;
+		}
+		return ReadMemory(PC++);
+
+	} // fetch8()
+
+	// read the next two instruction bytes as a 16-bit value
+	inline u16 fetch16()
+	{
+		u8 lsb = fetch8();
+		return lsb | (fetch8() << 8);
+
+	} // fetch16()
+
 	// Dummy Read for debugging
 	inline u8 dummyRead8(u16 addr)
 	{
@@ -251,6 +398,28 @@ namespace CPU
 		{
 			TICK; // +1 on Odd CPU Cycles (514)
 		}
+
+		// Source page is plain memory and the PPU wont look at OAM before the copy is done:
+		// land all 256 bytes at once and charge the 512 read/write cycles in one step
+		u8* page = readPages[bank >> 8];
+		if (page)
+		{
+			SyncPPU(frameCycle);
+			if (PPU::DotsToOAMRead(ppu) > (512 * 3))
+			{
+				PPU::WriteOAM(ppu, page);
+				cpuCycle	+= 512;
+				frameCycle	+= 512;
+
+				// NMI or Scanline IRQ due inside the copy is raised by the end of it, as the last OAMDATA write would
+				if (frameCycle >= nextPPUEvent)
+				{
+					SyncPPU(frameCycle);
+				}
+				return;
+			}
+		}
+
 		// PPU OAMDATA Write will Increment each times its written to
 		for (int i = 0; i < 256; i++)
 		{
@@ -265,19 +434,19 @@ namespace CPU
 		if (address == OAMDMA)
 		{
 			u16 bank = val * 0x0100;
-			CPU::DMA_OAM(bank);
+			DMA_OAM(bank);
 		}
 		else if (address == JOYPAD0)
 		{
-			Joypad::ToggleStrobe(val & 0x01);
+			Joypad::ToggleStrobe(joypad, val & 0x01);
 		}
 		else if (address == JOYPAD1_APU_COUNTER)
 		{
-			return APU::write8(elapsed(), address, val);
+			return APU::write8(apu, elapsed(), address, val);
 		}
 		else // APU
 		{
-			return APU::write8(elapsed(), address, val);
+			return APU::write8(apu, elapsed(), address, val);
 		}
 
 	} // WriteAPU_IO()
@@ -286,15 +455,15 @@ namespace CPU
 	{
 		if (address == JOYPAD0)
 		{
-			return Joypad::GetInput(0);
+			return Joypad::GetInput(joypad, 0);
 		}
 		else if (address == JOYPAD1_APU_COUNTER)
 		{
-			return Joypad::GetInput(1);
+			return Joypad::GetInput(joypad, 1);
 		}
 		else if (address == APU_STATUS)
 		{
-			return APU::read8( elapsed() ); 
+			return APU::read8(apu, elapsed()); 
 		}
 		else
 		{
@@ -305,18 +474,39 @@ namespace CPU
 
 	u8 WriteMemory(u16 address, u8 val)
 	{
-		u8* writeVal;
+#if DEBUG_COMPARE_BACKENDS
+		if (busLogMode != BUS_LOG_OFF)
+		{
+			return LoggedAccess(address, val, true);
+		}
+#endif
+		u8* page = writePages[address >> 8];
+		if (page)
+		{
+			return page[address & 0xFF] = val;
+		}
+		busWritten = true;
 
 		switch (GetMapLoc(address))
 		{
 		case CPU_MEMMAP::RAM:
 			return ram[address & 0x07FF] = val;
 		case CPU_MEMMAP::PPU:
-			return PPU::WriteMemory(address, val); 
+			SyncPPU(frameCycle);
+			PPU::WriteMemory(ppu, address, val);
+			ScheduleNextPPUEvent(); // register writes can move the next event ( NMI enable, rendering toggle )
+			return val;
 		case CPU_MEMMAP::APU_IO:
 			return WriteAPU_IO(address, val);
 		case CPU_MEMMAP::Cartridge:
-			return Cartridge::WritePRG(address, val);
+			SyncPPU(frameCycle); // bank switches must land on the right dot
+			CatchUpMapper();
+			val = mapper->write8(mapper->mapper, address, val);
+			if (mapperClocked)
+			{
+				ClockMapper(mapperSynced); // IRQ registers can move the next event
+			}
+			return val;
 		} // switch
 
 		return val;
@@ -325,18 +515,33 @@ namespace CPU
 
 	u8 ReadMemory(u16 address)
 	{
-		u8* readVal;
+#if DEBUG_COMPARE_BACKENDS
+		if (busLogMode != BUS_LOG_OFF)
+		{
+			return LoggedAccess(address, 0, false);
+		}
+#endif
+		u8* page = readPages[address >> 8];
+		if (page)
+		{
+			return page[address & 0xFF];
+		}
+		busReads++;
+		lastBusRead = address;
 
 		switch (GetMapLoc(address))
 		{
 		case CPU_MEMMAP::RAM:
 			return ram[address & 0x07FF];
 		case CPU_MEMMAP::PPU:
-			return PPU::ReadMemory(address); 
+			SyncPPU(frameCycle);
+			return PPU::ReadMemory(ppu, address); 
 		case CPU_MEMMAP::APU_IO:
 			return ReadAPU_IO(address);
 		case CPU_MEMMAP::Cartridge:
-			return Cartridge::ReadPRG(address);
+			SyncPPU(frameCycle); // mapper registers can expose PPU state
+			CatchUpMapper();
+			return mapper->read8(mapper->mapper, address);
 		} // switch
 
 		return 0;
@@ -346,18 +551,17 @@ namespace CPU
 	// Decrement the Cycle Clock
 	void Tick() 
 	{ 
-		waitCycles++; // Increment number of cycles to wait for PPU
-		timingCycle -= (1.0f / emulatorSpeed);
+		cpuCycle++;
+		frameCycle++;
 
 	} // Tick()
 
 	//-------------- Flag Updating --------------//
 
-	// Update two Flags; Negative and Zero
+	// Update two Flags; Negative and Zero ( kept as the result, resolved on read )
 	inline void Update_NZ(u8 val)
 	{ 
-		PF[_NEGATIVE]	= val & 0x80; 
-		PF[_ZERO]		= (val == 0);
+		PF.SetNZ(val);
 
 	} // Update_NZ()
 
@@ -370,7 +574,8 @@ namespace CPU
 
 	//-------------- Processor Flag Instructions --------------//
 
-	void ClearFlag(Flags flag)
+	template<Flags flag>
+	void ClearFlag()
 	{
 		PF[flag] = false; 
 		if (flag == _INTERUPT_DISABLE)
@@ -381,7 +586,8 @@ namespace CPU
 
 	} // ClearFlags
 
-	void SetFlag(Flags flag)
+	template<Flags flag>
+	void SetFlag()
 	{ 
 		PF[flag] = true; 
 		TICK; 
@@ -453,7 +659,8 @@ namespace CPU
 
 	} // Transfer X to Accumulator ( Affects Flags: N, Z )
 
-	void DEC( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void DEC()
 	{
 		FETCH_PARAMS;
 		u8 test = write8(addr, --val);
@@ -462,7 +669,8 @@ namespace CPU
 
 	} // Decrement Memory ( Affects Flags: N, Z )
 
-	void INC( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void INC()
 	{
 		FETCH_PARAMS;
 		u8 test = write8(addr, ++val);
@@ -524,7 +732,7 @@ namespace CPU
 	inline u16 immediate16(){ PC += 2; return PC-2; }
 
 	// use operand's value as address and return THAT value ( first 256 bytes of Memory Map )
-	inline u16 zeropage()	{ return read8( immediate8() ); };
+	inline u16 zeropage()	{ return fetch8(); };
 
 	// return zeropage + X register value
 	inline u16 zeropageX()	{ TICK; return (zeropage() + X) % 0x100; }
@@ -533,7 +741,7 @@ namespace CPU
 	inline u16 zeropageY()	{ TICK; return (zeropage() + Y) % 0x100; }
 
 	// return content from operand's address ( full 16-bit address )
-	inline u16 absolute()	{ return read16( immediate16() ); }
+	inline u16 absolute()	{ return fetch16(); }
 
 	// AbsoluteX Exception: add 1 cycle ( boundary crossed or not )
 	inline u16 absoluteX_Exc()	{ TICK; return absolute() + X; }
@@ -544,6 +752,9 @@ namespace CPU
 	// same as Absolute(), but add Y value to return value
 	inline u16 absoluteY()	{ u16 val = absolute(); if ( Cross(val, Y) ) TICK; return val + Y; }
 
+	// AbsoluteY Exception: add 1 cycle ( boundary crossed or not )
+	inline u16 absoluteY_Exc()	{ TICK; return absolute() + Y; }
+
 	// use zeropageX() value as address and return THAT value + X value
 	inline u16 indirectX()	{ u16 indir = zeropageX(); return directRead16(indir, (indir + 1) % 0x100); }
 
@@ -553,10 +764,14 @@ namespace CPU
 	// use zeropageY() value as address and return THAT value + Y value
 	inline u16 indirectY()	{ u16 indir = indirectY_Exc(); if ( Cross(indir - Y, Y) ) TICK; return indir; }
 
+	// IndirectY Store Exception: add 1 cycle ( boundary crossed or not )
+	inline u16 indirectY_Store()	{ TICK; return indirectY_Exc(); }
+
 	//------------------------------------------//
 
 	//-------------- 6502 Instructions --------------// 
-	void ADC( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void ADC()
 	{ 
 		FETCH_PARAMS; 
 		s16 res			= A + val + PF[_CARRY]; 
@@ -568,7 +783,8 @@ namespace CPU
 
 	} // Add with Carry ( Affects Flags: N, V, Z, C )
 
-	void SBC( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void SBC()
 	{
 		FETCH_PARAMS; 
 		s16 res			= A - val - !PF[_CARRY]; 
@@ -580,7 +796,8 @@ namespace CPU
 
 	} // Subtract with Carry ( Affects Flags: N, V, Z, C )
 
-	void AND( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void AND()
 	{
 		FETCH_PARAMS; 
 		A &= val;
@@ -588,7 +805,8 @@ namespace CPU
 
 	} // Bitwise & with Accumulator ( Affects Flags: N, Z )
 
-	void ORA( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void ORA()
 	{
 		FETCH_PARAMS;
 		A |= val;
@@ -597,7 +815,8 @@ namespace CPU
 
 	} // Bitwise | with Accumulator ( Affects Flags: N, Z )
 
-	void EOR( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void EOR()
 	{
 		FETCH_PARAMS;
 		A ^= val;
@@ -615,7 +834,8 @@ namespace CPU
 
 	} // Arithmetic Shift Left on Accumulator ( Affects Flags: N, Z, C )
 
-	void ASL( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void ASL()
 	{
 		FETCH_PARAMS; 
 		PF[_CARRY] = (val & 0x80); 
@@ -627,16 +847,17 @@ namespace CPU
 	} // Arithmetic Shift Left ( Affects Flags: N, Z, C )
 
 	// Same as AND, but only sets the flags, and throws away the result
-	void BIT( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void BIT()
 	{
 		FETCH_PARAMS; 
-		PF[_ZERO]		= !(A & val); 
-		PF[_NEGATIVE]	= val & 0x80; 
+		PF.SetNZ( val & 0x80, !(A & val) );
 		PF[_OVER_FLOW]	= val & 0x40;
 
 	} // Test Bits ( Affects Flags: N, V, Z )
 
-	void CMP( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void CMP()
 	{
 		FETCH_PARAMS; 
 		Update_NZ(A - val); 
@@ -644,7 +865,8 @@ namespace CPU
 
 	} // Compare Accumulator ( Affects Flags: N, Z, C )
 
-	void CPX( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void CPX()
 	{
 		FETCH_PARAMS; 
 		Update_NZ(X - val); 
@@ -652,7 +874,8 @@ namespace CPU
 
 	} // Compare X Register ( Affects Flags: S, Z, C )
 
-	void CPY( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void CPY()
 	{
 		FETCH_PARAMS;
 		Update_NZ(Y - val); 
@@ -661,46 +884,35 @@ namespace CPU
 
 	} // Compare Y Register ( Affects Flags: S, Z, C )
 
-	void STA( u16 addr ) 
+	template<u16(Core::*AddrMode)()>
+	void STA() 
 	{
+		u16 addr = (this->*AddrMode)();
 		write8( addr, A );
 		DebugOpCodeStore(addr, A); 
 
 	} // Store in Acculumulator ( Affects Flags: -- )
 
-	void STA(AddressMode mode)
-	{
-		TICK;
-		switch (mode)
-		{
-		case AddressMode::IndirectY:
-			STA( indirectY_Exc() );
-			break;
-		case AddressMode::AbsoluteX:
-			STA(absolute() + X);
-			break;
-		case AddressMode::AbsoluteY:
-			STA(absolute() + Y);
-			break;
-		}
-
-	} // // Store in Acculumulator ( Affects Flags: -- )
-
-	void STX(u16 addr)
+	template<u16(Core::*AddrMode)()>
+	void STX()
 	{
+		u16 addr = (this->*AddrMode)();
 		write8(addr, X);
 		DebugOpCodeStore(addr, X);
 
 	} // Store X Register ( Affects Flags: -- )
 
-	void STY(u16 addr)
+	template<u16(Core::*AddrMode)()>
+	void STY()
 	{
+		u16 addr = (this->*AddrMode)();
 		write8(addr, Y);
 		DebugOpCodeStore(addr, Y);
 
 	} // Store Y Register( Affects Flags: -- )
 
-	void LDA( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void LDA()
 	{
 		FETCH_PARAMS;
 		A = val;
@@ -709,7 +921,8 @@ namespace CPU
 
 	} // Load to Acculumulator ( Affects Flags: S, Z )
 
-	void LDX( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void LDX()
 	{
 		FETCH_PARAMS; 
 		X = val;
@@ -718,7 +931,8 @@ namespace CPU
 
 	} // Load to X Register ( Affects Flags: S, Z )
 
-	void LDY( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void LDY()
 	{
 		FETCH_PARAMS;
 		Y = val;
@@ -727,7 +941,8 @@ namespace CPU
 
 	} // Load to Y Register ( Affects Flags: S, Z )
 
-	void LSR( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void LSR()
 	{
 		FETCH_PARAMS;
 		PF[_CARRY] = val & 0x01;
@@ -749,7 +964,8 @@ namespace CPU
 
 	} // Logical Shift Accumulator Right ( Affects Flags: N, Z, C )
 
-	void ROR( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void ROR()
 	{
 		FETCH_PARAMS; 
 		u8 carry = PF[_CARRY] << 7;
@@ -772,7 +988,8 @@ namespace CPU
 
 	} // Roate Accumulator Right ( Affects Flags: N, Z, C )
 
-	void ROL( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void ROL()
 	{
 		FETCH_PARAMS; 
 		u8 carry = PF[_CARRY]; 
@@ -796,10 +1013,11 @@ namespace CPU
 	} // Roate Accumulator Left ( Affects Flags: N, Z, C )
 
 	// Flow Control Instructions
-	void Branch(Flags flag, bool val)
+	template<Flags flag, bool val>
+	void Branch()
 	{ 
-		s8 jumpTo = read8( immediate8() ); 
-		bool shouldBranch = (PF[flag] == val);
+		s8 jumpTo = fetch8(); 
+		bool shouldBranch = (PF.Test(flag) == val);
 		int printValue = PC + jumpTo;
 
 		if (shouldBranch)
@@ -824,14 +1042,14 @@ namespace CPU
 
 	void JMP() 
 	{ 
-		PC = read16( immediate16() ); 
+		PC = fetch16(); 
 		DebugOpCodePrefix( "$", PC );
 
 	} // Jump
 
 	void JMP_INDR()
 	{ 
-		u16 iAddr  = read16(immediate16());
+		u16 iAddr  = fetch16();
 		u16 iAddrB = (iAddr & 0xFF00) | ((iAddr + 1) & 0x00FF);
 		PC = directRead16( iAddr, iAddrB);
 
@@ -842,7 +1060,7 @@ namespace CPU
 		u16 store = PC + 1; 
 		Push( (store >> 8) & 0xFF ); // high byte
 		Push( store & 0xFF ); // low byte
-		PC = read16( immediate16() );
+		PC = fetch16();
 		TICK;
 		DebugOpCodePrefix("$", PC);
 
@@ -874,7 +1092,8 @@ namespace CPU
 
 	//-------------- Unofficial Instructions --------------//
 
-	void LAX( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void LAX()
 	{
 		FETCH_PARAMS;
 		A = val;
@@ -884,16 +1103,18 @@ namespace CPU
 
 	} // Combo of LDA and LDX
 
-	void SAX( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void SAX()
 	{
-		u16 addr = AddrMode();
+		u16 addr = (this->*AddrMode)();
 		u8 res = A & X;
 		write8( addr, res);
 		DebugOpCode(res);
 
 	} // Stores the bitwise AND of A and X ( no affected Flags )
 
-	void DCP( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void DCP()
 	{
 		FETCH_PARAMS;
 		val--;
@@ -905,7 +1126,8 @@ namespace CPU
 
 	} // Combo of Dec and CMP ( Affects Flags: N, Z, C )
 
-	void ISB( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void ISB()
 	{
 		FETCH_PARAMS;
 		val++;
@@ -919,7 +1141,8 @@ namespace CPU
 
 	} // Equivalent to INC value then SBC value ( Affects Flags: N, V, Z, C )
 
-	void SLO( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void SLO()
 	{
 		FETCH_PARAMS;
 		PF[_CARRY] = (val & 0x80);
@@ -930,7 +1153,8 @@ namespace CPU
 
 	} // Equivalent to ASL value then ORA value ( Affects Flags: N, Z, C )
 
-	void RLA( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void RLA()
 	{
 		FETCH_PARAMS;
 		u8 carry = PF[_CARRY];
@@ -943,7 +1167,8 @@ namespace CPU
 
 	} // Combo of ROL plus AND ( Affects Flags: V, N, Z, C )...no V?
 
-	void SRE( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void SRE()
 	{
 		FETCH_PARAMS;
 		PF[_CARRY] = val & 0x01;
@@ -955,7 +1180,8 @@ namespace CPU
 
 	} // Combo of LSR and EOR ( Affects Flags: N, Z, C )
 
-	void RRA( u16(*AddrMode)() )
+	template<u16(Core::*AddrMode)()>
+	void RRA()
 	{
 		FETCH_PARAMS;
 		u8 carry = PF[_CARRY] << 7;
@@ -971,7 +1197,8 @@ namespace CPU
 	} // Combo of ROR and ADC ( Affects Flags: V, N, Z, C )
 
 	// Unofficial NOPs ( result in different cycle count )
-	void MultiNOP( u8 code )
+	template<u8 code>
+	void MultiNOP()
 	{
 		switch ((code & 0x0F))
 		{
@@ -1061,319 +1288,975 @@ namespace CPU
 
 	} // Interupt()
 
-	// Execute OpCodes, one at a time, from ROM
-	void Execute()
-	{	
-		cpuCycle++;
+	//-------------- OpCode Dispatch --------------//
 
-		// Wait for PPU to run its steps
-		if (waitCycles > 1)
-		{
-			waitCycles--;
-			return;
-		}
-		nmiCycled = false;
-		irqCycled = false;
-		waitCycles = 0;
+	// Every opcode is an ( operation, addressing mode ) pair resolved at compile time
+	typedef void(Core::*OpHandler)();
+	OpHandler opTable[256];
 
-		// Grab Next OpCode, Increment ProgramCounter
-		u8 opCode = read8(PC++);
+	// Fill the whole table with unofficial NOPs, official opcodes are written over them
+	template<size_t... codes>
+	void FillMultiNOP(std::index_sequence<codes...>)
+	{
+		OpHandler nops[] = { &Core::MultiNOP<codes>... };
+		memcpy(opTable, nops, sizeof(opTable));
 
-#if DEBUG_DUMP_OPCODES
-		// Capture CPU Snapshot, and write to Dump File
-		if (Dev::IsCaptureRomDump())
-		{
-			Dev::WriteToRomDump( debugStream.str() );
-		}
-		std::cout << debugStream.str();
-		debugStream.str(""); // Clear Stream
-		DebugPrint( Dev::GetOpCodeName(opCode) );
-#endif
+	} // FillMultiNOP()
+
+	// Build the 256 entry OpCode Handler Table
+	void BuildOpTable()
+	{
+		FillMultiNOP( std::make_index_sequence<256>() );
 
-		// Execute 6502 Operation
- 		switch (opCode)
-		{
 		// BRK
-		case(0x00): return BREAK();
+		opTable[0x00] = &Core::BREAK;
 
 		// ADC ( Add with Carry )
-		case(0x69): return ADC(immediate8);
-		case(0x65): return ADC(zeropage);
-		case(0x75): return ADC(zeropageX);
-		case(0x6D): return ADC(absolute);
-		case(0x7D): return ADC(absoluteX);
-		case(0x79): return ADC(absoluteY);
-		case(0x61): return ADC(indirectX);
-		case(0x71): return ADC(indirectY);
+		opTable[0x69] = &Core::ADC<&Core::immediate8>;
+		opTable[0x65] = &Core::ADC<&Core::zeropage>;
+		opTable[0x75] = &Core::ADC<&Core::zeropageX>;
+		opTable[0x6D] = &Core::ADC<&Core::absolute>;
+		opTable[0x7D] = &Core::ADC<&Core::absoluteX>;
+		opTable[0x79] = &Core::ADC<&Core::absoluteY>;
+		opTable[0x61] = &Core::ADC<&Core::indirectX>;
+		opTable[0x71] = &Core::ADC<&Core::indirectY>;
 
 		// SBC ( Subtract with Carry )
-		case(0xE9): return SBC(immediate8);
-		case(0xE5): return SBC(zeropage);
-		case(0xF5): return SBC(zeropageX);
-		case(0xED): return SBC(absolute);
-		case(0xFD): return SBC(absoluteX);
-		case(0xF9): return SBC(absoluteY);
-		case(0xE1): return SBC(indirectX);
-		case(0xF1): return SBC(indirectY);
+		opTable[0xE9] = &Core::SBC<&Core::immediate8>;
+		opTable[0xE5] = &Core::SBC<&Core::zeropage>;
+		opTable[0xF5] = &Core::SBC<&Core::zeropageX>;
+		opTable[0xED] = &Core::SBC<&Core::absolute>;
+		opTable[0xFD] = &Core::SBC<&Core::absoluteX>;
+		opTable[0xF9] = &Core::SBC<&Core::absoluteY>;
+		opTable[0xE1] = &Core::SBC<&Core::indirectX>;
+		opTable[0xF1] = &Core::SBC<&Core::indirectY>;
 
 		// AND ( Bitwise & with Accumulator )
-		case(0x29): return AND(immediate8);
-		case(0x25): return AND(zeropage);
-		case(0x35): return AND(zeropageX);
-		case(0x2D): return AND(absolute);
-		case(0x3D): return AND(absoluteX);
-		case(0x39): return AND(absoluteY);
-		case(0x21): return AND(indirectX);
-		case(0x31): return AND(indirectY);
+		opTable[0x29] = &Core::AND<&Core::immediate8>;
+		opTable[0x25] = &Core::AND<&Core::zeropage>;
+		opTable[0x35] = &Core::AND<&Core::zeropageX>;
+		opTable[0x2D] = &Core::AND<&Core::absolute>;
+		opTable[0x3D] = &Core::AND<&Core::absoluteX>;
+		opTable[0x39] = &Core::AND<&Core::absoluteY>;
+		opTable[0x21] = &Core::AND<&Core::indirectX>;
+		opTable[0x31] = &Core::AND<&Core::indirectY>;
 
 		// ORA ( Bitwise Inclusive OR with Accumulator )
-		case(0x09): return ORA(immediate8);
-		case(0x05): return ORA(zeropage);
-		case(0x15): return ORA(zeropageX);
-		case(0x0D): return ORA(absolute);
-		case(0x1D): return ORA(absoluteX);
-		case(0x19): return ORA(absoluteY);
-		case(0x01): return ORA(indirectX);
-		case(0x11): return ORA(indirectY);
+		opTable[0x09] = &Core::ORA<&Core::immediate8>;
+		opTable[0x05] = &Core::ORA<&Core::zeropage>;
+		opTable[0x15] = &Core::ORA<&Core::zeropageX>;
+		opTable[0x0D] = &Core::ORA<&Core::absolute>;
+		opTable[0x1D] = &Core::ORA<&Core::absoluteX>;
+		opTable[0x19] = &Core::ORA<&Core::absoluteY>;
+		opTable[0x01] = &Core::ORA<&Core::indirectX>;
+		opTable[0x11] = &Core::ORA<&Core::indirectY>;
 
 		// EOR ( Bitwise XOR )
-		case(0x49): return EOR(immediate8);
-		case(0x45): return EOR(zeropage);
-		case(0x55): return EOR(zeropageX);
-		case(0x4D): return EOR(absolute);
-		case(0x5D): return EOR(absoluteX);
-		case(0x59): return EOR(absoluteY);
-		case(0x41): return EOR(indirectX);
-		case(0x51): return EOR(indirectY);
+		opTable[0x49] = &Core::EOR<&Core::immediate8>;
+		opTable[0x45] = &Core::EOR<&Core::zeropage>;
+		opTable[0x55] = &Core::EOR<&Core::zeropageX>;
+		opTable[0x4D] = &Core::EOR<&Core::absolute>;
+		opTable[0x5D] = &Core::EOR<&Core::absoluteX>;
+		opTable[0x59] = &Core::EOR<&Core::absoluteY>;
+		opTable[0x41] = &Core::EOR<&Core::indirectX>;
+		opTable[0x51] = &Core::EOR<&Core::indirectY>;
 
 		// ASL ( Arithmetic Shift Left ) 
-		case(0x0A): return ASL_A();
-		case(0x06): return ASL(zeropage);
-		case(0x16): return ASL(zeropageX);
-		case(0x0E): return ASL(absolute);
-		case(0x1E): return ASL(absoluteX_Exc);
+		opTable[0x0A] = &Core::ASL_A;
+		opTable[0x06] = &Core::ASL<&Core::zeropage>;
+		opTable[0x16] = &Core::ASL<&Core::zeropageX>;
+		opTable[0x0E] = &Core::ASL<&Core::absolute>;
+		opTable[0x1E] = &Core::ASL<&Core::absoluteX_Exc>;
 
 		// BIT ( Test Bits )
-		case(0x24): return BIT(zeropage);
-		case(0x2C): return BIT(absolute);
+		opTable[0x24] = &Core::BIT<&Core::zeropage>;
+		opTable[0x2C] = &Core::BIT<&Core::absolute>;
 
 		// CMP ( Compare Accumulator )
-		case(0xC9): return CMP(immediate8);
-		case(0xC5): return CMP(zeropage);
-		case(0xD5): return CMP(zeropageX);
-		case(0xCD): return CMP(absolute);
-		case(0xDD): return CMP(absoluteX);
-		case(0xD9): return CMP(absoluteY);
-		case(0xC1): return CMP(indirectX);
-		case(0xD1): return CMP(indirectY);
+		opTable[0xC9] = &Core::CMP<&Core::immediate8>;
+		opTable[0xC5] = &Core::CMP<&Core::zeropage>;
+		opTable[0xD5] = &Core::CMP<&Core::zeropageX>;
+		opTable[0xCD] = &Core::CMP<&Core::absolute>;
+		opTable[0xDD] = &Core::CMP<&Core::absoluteX>;
+		opTable[0xD9] = &Core::CMP<&Core::absoluteY>;
+		opTable[0xC1] = &Core::CMP<&Core::indirectX>;
+		opTable[0xD1] = &Core::CMP<&Core::indirectY>;
 
 		// CPX ( Compare X Register )
-		case(0xE0): return CPX(immediate8);
-		case(0xE4): return CPX(zeropage);
-		case(0xEC): return CPX(absolute);
+		opTable[0xE0] = &Core::CPX<&Core::immediate8>;
+		opTable[0xE4] = &Core::CPX<&Core::zeropage>;
+		opTable[0xEC] = &Core::CPX<&Core::absolute>;
 
 		// CPY ( Compare X Register )
-		case(0xC0): return CPY(immediate8);
-		case(0xC4): return CPY(zeropage);
-		case(0xCC): return CPY(absolute);
+		opTable[0xC0] = &Core::CPY<&Core::immediate8>;
+		opTable[0xC4] = &Core::CPY<&Core::zeropage>;
+		opTable[0xCC] = &Core::CPY<&Core::absolute>;
 
 		// STA ( Store Accumulator )
-		case(0x85): return STA( zeropage() );
-		case(0x95): return STA( zeropageX() );
-		case(0x8D): return STA( absolute() );
-		case(0x9D): return STA( AbsoluteX );
-		case(0x99): return STA( AbsoluteY );
-		case(0x81): return STA( indirectX() );
-		case(0x91): return STA( IndirectY );
+		opTable[0x85] = &Core::STA<&Core::zeropage>;
+		opTable[0x95] = &Core::STA<&Core::zeropageX>;
+		opTable[0x8D] = &Core::STA<&Core::absolute>;
+		opTable[0x9D] = &Core::STA<&Core::absoluteX_Exc>;
+		opTable[0x99] = &Core::STA<&Core::absoluteY_Exc>;
+		opTable[0x81] = &Core::STA<&Core::indirectX>;
+		opTable[0x91] = &Core::STA<&Core::indirectY_Store>;
 
 		// STX ( Store X Register )
-		case(0x86): return STX( zeropage() );
-		case(0x96): return STX( zeropageY() );
-		case(0x8E): return STX( absolute() );
+		opTable[0x86] = &Core::STX<&Core::zeropage>;
+		opTable[0x96] = &Core::STX<&Core::zeropageY>;
+		opTable[0x8E] = &Core::STX<&Core::absolute>;
 
 		// STY ( Store Y Register )
-		case(0x84): return STY( zeropage() );
-		case(0x94): return STY( zeropageX() );
-		case(0x8C): return STY( absolute() );
+		opTable[0x84] = &Core::STY<&Core::zeropage>;
+		opTable[0x94] = &Core::STY<&Core::zeropageX>;
+		opTable[0x8C] = &Core::STY<&Core::absolute>;
 
 		// LDA ( Load to Accumulator )
-		case(0xA9): return LDA(immediate8);
-		case(0xA5): return LDA(zeropage);
-		case(0xB5): return LDA(zeropageX);
-		case(0xAD): return LDA(absolute);
-		case(0xBD): return LDA(absoluteX);
-		case(0xB9): return LDA(absoluteY);
-		case(0xA1): return LDA(indirectX);
-		case(0xB1): return LDA(indirectY);
+		opTable[0xA9] = &Core::LDA<&Core::immediate8>;
+		opTable[0xA5] = &Core::LDA<&Core::zeropage>;
+		opTable[0xB5] = &Core::LDA<&Core::zeropageX>;
+		opTable[0xAD] = &Core::LDA<&Core::absolute>;
+		opTable[0xBD] = &Core::LDA<&Core::absoluteX>;
+		opTable[0xB9] = &Core::LDA<&Core::absoluteY>;
+		opTable[0xA1] = &Core::LDA<&Core::indirectX>;
+		opTable[0xB1] = &Core::LDA<&Core::indirectY>;
 
 		// LDX ( Load to X Register )
-		case(0xA2): return LDX(immediate8);
-		case(0xA6): return LDX(zeropage);
-		case(0xB6): return LDX(zeropageY);
-		case(0xAE): return LDX(absolute);
-		case(0xBE): return LDX(absoluteY);
+		opTable[0xA2] = &Core::LDX<&Core::immediate8>;
+		opTable[0xA6] = &Core::LDX<&Core::zeropage>;
+		opTable[0xB6] = &Core::LDX<&Core::zeropageY>;
+		opTable[0xAE] = &Core::LDX<&Core::absolute>;
+		opTable[0xBE] = &Core::LDX<&Core::absoluteY>;
 
 		// LDY ( Load to Y Register )
-		case(0xA0): return LDY(immediate8);
-		case(0xA4): return LDY(zeropage);
-		case(0xB4): return LDY(zeropageX);
-		case(0xAC): return LDY(absolute);
-		case(0xBC): return LDY(absoluteX);
+		opTable[0xA0] = &Core::LDY<&Core::immediate8>;
+		opTable[0xA4] = &Core::LDY<&Core::zeropage>;
+		opTable[0xB4] = &Core::LDY<&Core::zeropageX>;
+		opTable[0xAC] = &Core::LDY<&Core::absolute>;
+		opTable[0xBC] = &Core::LDY<&Core::absoluteX>;
 
 		// INC ( Increment Memory )
-		case(0xE6): return INC(zeropage);
-		case(0xF6): return INC(zeropageX);
-		case(0xEE): return INC(absolute);
-		case(0xFE): return INC(absoluteX_Exc);
+		opTable[0xE6] = &Core::INC<&Core::zeropage>;
+		opTable[0xF6] = &Core::INC<&Core::zeropageX>;
+		opTable[0xEE] = &Core::INC<&Core::absolute>;
+		opTable[0xFE] = &Core::INC<&Core::absoluteX_Exc>;
 
 		// DEC ( Decrement Memory )
-		case(0xC6): return DEC(zeropage);
-		case(0xD6): return DEC(zeropageX);
-		case(0xCE): return DEC(absolute);
-		case(0xDE): return DEC(absoluteX_Exc);
+		opTable[0xC6] = &Core::DEC<&Core::zeropage>;
+		opTable[0xD6] = &Core::DEC<&Core::zeropageX>;
+		opTable[0xCE] = &Core::DEC<&Core::absolute>;
+		opTable[0xDE] = &Core::DEC<&Core::absoluteX_Exc>;
 
 		// LSR ( Logical Shift Right )
-		case(0x4A): return LSR_A();
-		case(0x46): return LSR(zeropage);
-		case(0x56): return LSR(zeropageX);
-		case(0x4E): return LSR(absolute);
-		case(0x5E): return LSR(absoluteX_Exc);
+		opTable[0x4A] = &Core::LSR_A;
+		opTable[0x46] = &Core::LSR<&Core::zeropage>;
+		opTable[0x56] = &Core::LSR<&Core::zeropageX>;
+		opTable[0x4E] = &Core::LSR<&Core::absolute>;
+		opTable[0x5E] = &Core::LSR<&Core::absoluteX_Exc>;
 
 		// ROL ( Rotate Left )
-		case(0x2A): return ROL_A();
-		case(0x26): return ROL(zeropage);
-		case(0x36): return ROL(zeropageX);
-		case(0x2E): return ROL(absolute);
-		case(0x3E): return ROL(absoluteX_Exc);
+		opTable[0x2A] = &Core::ROL_A;
+		opTable[0x26] = &Core::ROL<&Core::zeropage>;
+		opTable[0x36] = &Core::ROL<&Core::zeropageX>;
+		opTable[0x2E] = &Core::ROL<&Core::absolute>;
+		opTable[0x3E] = &Core::ROL<&Core::absoluteX_Exc>;
 
 		// ROR ( Rotate Right )
-		case(0x6A): return ROR_A();
-		case(0x66): return ROR(zeropage);
-		case(0x76): return ROR(zeropageX);
-		case(0x6E): return ROR(absolute);
-		case(0x7E): return ROR(absoluteX_Exc);
+		opTable[0x6A] = &Core::ROR_A;
+		opTable[0x66] = &Core::ROR<&Core::zeropage>;
+		opTable[0x76] = &Core::ROR<&Core::zeropageX>;
+		opTable[0x6E] = &Core::ROR<&Core::absolute>;
+		opTable[0x7E] = &Core::ROR<&Core::absoluteX_Exc>;
 
 		// Branches
-		case(0x10): return Branch(_NEGATIVE, false);	// BPL, on Plus
-		case(0x30): return Branch(_NEGATIVE, true);		// BMI, on Minus
-		case(0x50): return Branch(_OVER_FLOW, false);	// BVC, on Overflow Clear
-		case(0x70): return Branch(_OVER_FLOW, true);	// BVS, on Overflow Set
-		case(0x90): return Branch(_CARRY, false);		// BCC, on Carry Clear
-		case(0xB0): return Branch(_CARRY, true);		// BCS, on Carry Set
-		case(0xD0): return Branch(_ZERO, false);		// BNE, on Not Equal
-		case(0xF0): return Branch(_ZERO, true);			// BEQ, on Equal
+		opTable[0x10] = &Core::Branch<_NEGATIVE, false>;	// BPL, on Plus
+		opTable[0x30] = &Core::Branch<_NEGATIVE, true>;	// BMI, on Minus
+		opTable[0x50] = &Core::Branch<_OVER_FLOW, false>;	// BVC, on Overflow Clear
+		opTable[0x70] = &Core::Branch<_OVER_FLOW, true>;	// BVS, on Overflow Set
+		opTable[0x90] = &Core::Branch<_CARRY, false>;	// BCC, on Carry Clear
+		opTable[0xB0] = &Core::Branch<_CARRY, true>;	// BCS, on Carry Set
+		opTable[0xD0] = &Core::Branch<_ZERO, false>;	// BNE, on Not Equal
+		opTable[0xF0] = &Core::Branch<_ZERO, true>;		// BEQ, on Equal
 
 		// JMP ( Jump or Indirect Jump )
-		case(0x4C): return JMP();
-		case(0x6C): return JMP_INDR();
+		opTable[0x4C] = &Core::JMP;
+		opTable[0x6C] = &Core::JMP_INDR;
 
 		// JSR ( Jump to Subroutine )
-		case(0x20): return JSR();
+		opTable[0x20] = &Core::JSR;
 
 		// RTS ( Return from Subroutine )
-		case(0x60): return RTS();
+		opTable[0x60] = &Core::RTS;
 
 		// RTI ( Return from Interupt )
-		case(0x40): return RTI();
+		opTable[0x40] = &Core::RTI;
 
 		// Stack Instructions
-		case(0x9A): return TXS();
-		case(0xBA): return TSX();
-		case(0x48): return PHA();
-		case(0x68): return PLA();
-		case(0x08): return PHP();
-		case(0x28): return PLP();
+		opTable[0x9A] = &Core::TXS;
+		opTable[0xBA] = &Core::TSX;
+		opTable[0x48] = &Core::PHA;
+		opTable[0x68] = &Core::PLA;
+		opTable[0x08] = &Core::PHP;
+		opTable[0x28] = &Core::PLP;
 
 		//-------------- Register Instructions --------------//
-		case(0xAA): return TAX();
-		case(0x8A): return TXA();
-		case(0xCA): return DEX();
-		case(0xE8): return INX();
-		case(0xA8): return TAY();
-		case(0x98): return TYA();
-		case(0x88): return DEY();
-		case(0xC8): return INY();
+		opTable[0xAA] = &Core::TAX;
+		opTable[0x8A] = &Core::TXA;
+		opTable[0xCA] = &Core::DEX;
+		opTable[0xE8] = &Core::INX;
+		opTable[0xA8] = &Core::TAY;
+		opTable[0x98] = &Core::TYA;
+		opTable[0x88] = &Core::DEY;
+		opTable[0xC8] = &Core::INY;
 
 		// Processor Flag
-		case(0x18): return ClearFlag(_CARRY);
-		case(0x38): return SetFlag(_CARRY);
-		case(0x58): return ClearFlag(_INTERUPT_DISABLE);
-		case(0x78): return SetFlag(_INTERUPT_DISABLE);
-		case(0xB8): return ClearFlag(_OVER_FLOW);
-		case(0xD8): return ClearFlag(_DECIMAL_MODE);
-		case(0xF8): return SetFlag(_DECIMAL_MODE);
+		opTable[0x18] = &Core::ClearFlag<_CARRY>;
+		opTable[0x38] = &Core::SetFlag<_CARRY>;
+		opTable[0x58] = &Core::ClearFlag<_INTERUPT_DISABLE>;
+		opTable[0x78] = &Core::SetFlag<_INTERUPT_DISABLE>;
+		opTable[0xB8] = &Core::ClearFlag<_OVER_FLOW>;
+		opTable[0xD8] = &Core::ClearFlag<_DECIMAL_MODE>;
+		opTable[0xF8] = &Core::SetFlag<_DECIMAL_MODE>;
 
 		//-------------- Unofficial OpCodes --------------//
-		case(0xAF): return LAX(absolute);
-		case(0xBF): return LAX(absoluteY);
-		case(0xA7): return LAX(zeropage);
-		case(0xB7): return LAX(zeropageY);
-		case(0xA3): return LAX(indirectX);
-		case(0xB3): return LAX(indirectY);
-
-		case(0x83): return SAX(indirectX);
-		case(0x87): return SAX(zeropage);
-		case(0x8F): return SAX(absolute);
-		case(0x97): return SAX(zeropageY);
-
-		case(0xC7): return DCP(zeropage);
-		case(0xD7): return DCP(zeropageX);
-		case(0xCF): return DCP(absolute);
-		case(0xDF): return DCP(absoluteX);
-		case(0xDB): return DCP(absoluteY);
-		case(0xC3): return DCP(indirectX);
-		case(0xD3): return DCP(indirectY);
-
-		case(0xE7): return ISB(zeropage);
-		case(0xF7): return ISB(zeropageX);
-		case(0xEF): return ISB(absolute);
-		case(0xFF): return ISB(absoluteX);
-		case(0xFB): return ISB(absoluteY);
-		case(0xE3): return ISB(indirectX);
-		case(0xF3): return ISB(indirectY);
-
-		case(0x07): return SLO(zeropage);
-		case(0x17): return SLO(zeropageX);
-		case(0x0F): return SLO(absolute);
-		case(0x1F): return SLO(absoluteX);
-		case(0x1B): return SLO(absoluteY);
-		case(0x03): return SLO(indirectX);
-		case(0x13): return SLO(indirectY);
-
-		case(0x27): return RLA(zeropage);
-		case(0x37): return RLA(zeropageX);
-		case(0x2F): return RLA(absolute);
-		case(0x3F): return RLA(absoluteX);
-		case(0x3B): return RLA(absoluteY);
-		case(0x23): return RLA(indirectX);
-		case(0x33): return RLA(indirectY);
-
-		case(0x47): return SRE(zeropage);
-		case(0x57): return SRE(zeropageX);
-		case(0x4F): return SRE(absolute);
-		case(0x5F): return SRE(absoluteX);
-		case(0x5B): return SRE(absoluteY);
-		case(0x43): return SRE(indirectX);
-		case(0x53): return SRE(indirectY);
-
-		case(0x67): return RRA(zeropage);
-		case(0x77): return RRA(zeropageX);
-		case(0x6F): return RRA(absolute);
-		case(0x7F): return RRA(absoluteX);
-		case(0x7B): return RRA(absoluteY);
-		case(0x63): return RRA(indirectX);
-		case(0x73): return RRA(indirectY);
+		opTable[0xAF] = &Core::LAX<&Core::absolute>;
+		opTable[0xBF] = &Core::LAX<&Core::absoluteY>;
+		opTable[0xA7] = &Core::LAX<&Core::zeropage>;
+		opTable[0xB7] = &Core::LAX<&Core::zeropageY>;
+		opTable[0xA3] = &Core::LAX<&Core::indirectX>;
+		opTable[0xB3] = &Core::LAX<&Core::indirectY>;
+
+		opTable[0x83] = &Core::SAX<&Core::indirectX>;
+		opTable[0x87] = &Core::SAX<&Core::zeropage>;
+		opTable[0x8F] = &Core::SAX<&Core::absolute>;
+		opTable[0x97] = &Core::SAX<&Core::zeropageY>;
+
+		opTable[0xC7] = &Core::DCP<&Core::zeropage>;
+		opTable[0xD7] = &Core::DCP<&Core::zeropageX>;
+		opTable[0xCF] = &Core::DCP<&Core::absolute>;
+		opTable[0xDF] = &Core::DCP<&Core::absoluteX>;
+		opTable[0xDB] = &Core::DCP<&Core::absoluteY>;
+		opTable[0xC3] = &Core::DCP<&Core::indirectX>;
+		opTable[0xD3] = &Core::DCP<&Core::indirectY>;
+
+		opTable[0xE7] = &Core::ISB<&Core::zeropage>;
+		opTable[0xF7] = &Core::ISB<&Core::zeropageX>;
+		opTable[0xEF] = &Core::ISB<&Core::absolute>;
+		opTable[0xFF] = &Core::ISB<&Core::absoluteX>;
+		opTable[0xFB] = &Core::ISB<&Core::absoluteY>;
+		opTable[0xE3] = &Core::ISB<&Core::indirectX>;
+		opTable[0xF3] = &Core::ISB<&Core::indirectY>;
+
+		opTable[0x07] = &Core::SLO<&Core::zeropage>;
+		opTable[0x17] = &Core::SLO<&Core::zeropageX>;
+		opTable[0x0F] = &Core::SLO<&Core::absolute>;
+		opTable[0x1F] = &Core::SLO<&Core::absoluteX>;
+		opTable[0x1B] = &Core::SLO<&Core::absoluteY>;
+		opTable[0x03] = &Core::SLO<&Core::indirectX>;
+		opTable[0x13] = &Core::SLO<&Core::indirectY>;
+
+		opTable[0x27] = &Core::RLA<&Core::zeropage>;
+		opTable[0x37] = &Core::RLA<&Core::zeropageX>;
+		opTable[0x2F] = &Core::RLA<&Core::absolute>;
+		opTable[0x3F] = &Core::RLA<&Core::absoluteX>;
+		opTable[0x3B] = &Core::RLA<&Core::absoluteY>;
+		opTable[0x23] = &Core::RLA<&Core::indirectX>;
+		opTable[0x33] = &Core::RLA<&Core::indirectY>;
+
+		opTable[0x47] = &Core::SRE<&Core::zeropage>;
+		opTable[0x57] = &Core::SRE<&Core::zeropageX>;
+		opTable[0x4F] = &Core::SRE<&Core::absolute>;
+		opTable[0x5F] = &Core::SRE<&Core::absoluteX>;
+		opTable[0x5B] = &Core::SRE<&Core::absoluteY>;
+		opTable[0x43] = &Core::SRE<&Core::indirectX>;
+		opTable[0x53] = &Core::SRE<&Core::indirectY>;
+
+		opTable[0x67] = &Core::RRA<&Core::zeropage>;
+		opTable[0x77] = &Core::RRA<&Core::zeropageX>;
+		opTable[0x6F] = &Core::RRA<&Core::absolute>;
+		opTable[0x7F] = &Core::RRA<&Core::absoluteX>;
+		opTable[0x7B] = &Core::RRA<&Core::absoluteY>;
+		opTable[0x63] = &Core::RRA<&Core::indirectX>;
+		opTable[0x73] = &Core::RRA<&Core::indirectY>;
 		//------------------------------------------//
 
 		// Misc
-		case(0xEB): return SBC(immediate8); // *Same as Legal 0xE9
-		case(0xEA): return NOP();
-		default: return MultiNOP(opCode);
-			
-		} // switch
+		opTable[0xEB] = &Core::SBC<&Core::immediate8>; // *Same as Legal 0xE9
+		opTable[0xEA] = &Core::NOP;
+
+	} // BuildOpTable()
+
+	//-------------- Decoded Instruction Cache --------------//
+
+	// An instruction out of PRG ROM, decoded the first time it runs
+	struct DecodedOp
+	{
+		OpHandler	handler;		// nullptr until decoded
+		u8			opCode;
+		u8			operands[2];	// up to two bytes following the opcode
+
+	}; // DecodedOp
+
+	DecodedOp* opCache = nullptr; // one entry per PRG ROM byte
+
+	// A straight run of decoded instructions ( see Block Backend )
+	struct Block
+	{
+		int			count;
+		bool		idleCandidate;	// short, read-only and ends in a branch/jump ( see Idle Loops )
+		DecodedOp*	ops[BLOCK_MAX_OPS];
+
+	}; // Block
+
+	Block** blockCache	= nullptr;	// one slot per PRG ROM byte, keyed by the block's first instruction
+	u32 blockCacheSize	= 0;
+
+	void ResetOpCache()
+	{
+		for (u32 i = 0; i < blockCacheSize; i++)
+		{
+			delete blockCache[i];
+		} // for
+		delete[] blockCache;
+		delete[] opCache;
+
+		blockCacheSize	= prgROMSize;
+		blockCache		= prgROMSize ? new Block*[prgROMSize]() : nullptr;
+		opCache			= prgROMSize ? new DecodedOp[prgROMSize]() : nullptr;
+
+	} // ResetOpCache()
+
+	// Cartridge's PRG ROM, a new Cartridge starts with an empty Decoded Instruction Cache
+	void SetPRGROM(u8* prg, u32 size)
+	{
+		prgROM		= prg;
+		prgROMSize	= size;
+		ResetOpCache();
+
+	} // SetPRGROM()
+
+	// Decoded Instruction Cache goes with the Core
+	~Core()
+	{
+		SetPRGROM(nullptr, 0);
+
+	} // ~Core()
+
+	// Find the decoded instruction at an address, nullptr if it has to run off the bus
+	inline DecodedOp* LookupOp(u16 address)
+	{
+		// RAM, PRG RAM and anything handled by the Memory Map bypass the cache
+		u8* page = readPages[address >> 8];
+		if (!page || page < prgROM || page >= prgROM + prgROMSize)
+		{
+			return nullptr;
+		}
+
+		// ROM never changes, so the entry stays good through bank switches. Only instructions that
+		// could spill into the next 8K slot ( mapped to some other bank ) are left uncached
+		u32 offset = (page - prgROM) + (address & 0xFF);
+		if ((offset % K_8) > (K_8 - 3))
+		{
+			return nullptr;
+		}
+
+		DecodedOp* op = &opCache[offset];
+		if (!op->handler)
+		{
+			op->opCode		= prgROM[offset];
+			op->operands[0]	= prgROM[offset + 1];
+			op->operands[1]	= prgROM[offset + 2];
+			op->handler		= opTable[op->opCode];
+		}
+		return op;
+
+	} // LookupOp()
+
+	// Execute OpCodes, one at a time, from ROM
+	void Execute()
+	{	
+		nmiCycled = false;
+		irqCycled = false;
+		opCycle = frameCycle;
+
+		// Grab Next OpCode, Increment ProgramCounter ( already decoded if running from PRG ROM )
+		DecodedOp* decoded = LookupOp(PC);
+		u8 opCode;
+		if (decoded)
+		{
+			TICK;
+			PC++;
+			opCode			= decoded->opCode;
+			fetchOperand	= decoded->operands;
+		}
+		else
+		{
+			opCode = read8(PC++);
+		}
+
+#if DEBUG_DUMP_OPCODES
+		// Capture CPU Snapshot, and write to Dump File
+		if (Dev::IsCaptureRomDump())
+		{
+			Dev::WriteToRomDump( debugStream.str() );
+		}
+		std::cout << debugStream.str();
+		debugStream.str(""); // Clear Stream
+		DebugPrint( Dev::GetOpCodeName(opCode) );
+#endif
+
+		// Execute 6502 Operation
+		if (decoded)
+		{
+			(this->*decoded->handler)();
+			fetchOperand = nullptr;
+		}
+		else
+		{
+			(this->*opTable[opCode])();
+		}
 
 	} // Execute()
 
+	//-------------- Block Backend --------------//
+
+	// Straight runs of PRG ROM are recorded the first time through, then their decoded instructions
+	// run back to back. A block hands control back to RunFrame as soon as something outside the CPU
+	// could see it ( Memory Map access, pending interupt, PPU event due, end of frame ), so cycle
+	// accounting and ordering match the interpreter. Execute() stays the reference backend.
+
+	bool useBlocks = !DEBUG_DUMP_OPCODES; // opcode dumps come from the interpreter
+
+	bool ToggleBlockBackend()
+	{
+		useBlocks = !useBlocks;
+		return useBlocks;
+
+	} // ToggleBlockBackend()
+
+	// Branches, Jumps, Returns and BRK end a block
+	inline bool EndsBlock(u8 opCode)
+	{
+		return ((opCode & 0x1F) == 0x10) || opCode == 0x00 || opCode == 0x20 || opCode == 0x40 
+			|| opCode == 0x4C || opCode == 0x60 || opCode == 0x6C;
+
+	} // EndsBlock()
+
+	// True if RunFrame has to see to something before the next instruction
+	inline bool ShouldLeaveBlock()
+	{
+		return busWritten || nmiFlag || irqFlag || (frameCycle + 1 >= nextPPUEvent) || (frameCycle >= timingCycle);
+
+	} // ShouldLeaveBlock()
+
+	// Run a single decoded instruction
+	inline void RunOp(DecodedOp* op)
+	{
+		nmiCycled = false;
+		irqCycled = false;
+		opCycle = frameCycle;
+
+		TICK; // OpCode fetch
+		PC++;
+		fetchOperand = op->operands;
+		(this->*op->handler)();
+		fetchOperand = nullptr;
+
+	} // RunOp()
+
+	//-------------- Idle Loops --------------//
+
+	// Waiting loops ( LDA $2002/BPL, LDA flag/BEQ, JMP * ) only read RAM or the PPU status, so once a pass
+	// leaves the CPU exactly as it found it, every following pass does the same until something outside
+	// the CPU steps in. Those passes are skipped by just moving the clock, stopping short of the next
+	// NMI/Scanline event, the end of the frame or a CPU-Counter Mapper raising an IRQ. PPU and APU are
+	// timed off the same clock, so they catch up as if the loop had run. ( APU IRQs are not wired up )
+
+	// Instructions that only read memory and set registers/flags
+	inline bool IsReadOnlyOp(u8 opCode)
+	{
+		switch (opCode)
+		{
+		case 0xA9: case 0xA5: case 0xB5: case 0xAD: case 0xBD: case 0xB9: case 0xA1: case 0xB1: // LDA
+		case 0xA2: case 0xA6: case 0xB6: case 0xAE: case 0xBE: // LDX
+		case 0xA0: case 0xA4: case 0xB4: case 0xAC: case 0xBC: // LDY
+		case 0xC9: case 0xC5: case 0xD5: case 0xCD: case 0xDD: case 0xD9: case 0xC1: case 0xD1: // CMP
+		case 0xE0: case 0xE4: case 0xEC: // CPX
+		case 0xC0: case 0xC4: case 0xCC: // CPY
+		case 0x29: case 0x25: case 0x35: case 0x2D: case 0x3D: case 0x39: case 0x21: case 0x31: // AND
+		case 0x24: case 0x2C: // BIT
+		case 0xEA: // NOP
+		case 0x10: case 0x30: case 0x50: case 0x70: case 0x90: case 0xB0: case 0xD0: case 0xF0: // Branches
+		case 0x4C: // JMP
+			return true;
+		default:
+			return false;
+		} // switch
+
+	} // IsReadOnlyOp()
+
+	// Short block of read-only instructions that ends in a branch or jump
+	bool IsIdleCandidate(Block* block)
+	{
+		u8 lastOp = block->ops[block->count - 1]->opCode;
+		if (block->count > IDLE_LOOP_MAX_OPS || !(((lastOp & 0x1F) == 0x10) || lastOp == 0x4C))
+		{
+			return false;
+		}
+		for (int i = 0; i < block->count; i++)
+		{
+			if (!IsReadOnlyOp(block->ops[i]->opCode))
+			{
+				return false;
+			}
+		} // for
+		return true;
+
+	} // IsIdleCandidate()
+
+	// One pass through a candidate loop
+	struct IdleLoop
+	{
+		// CPU after each instruction
+		struct Step
+		{
+			u16 PC;
+			u8	A, X, Y, P;
+			int cycles;
+
+		}; // Step
+
+		u16		startPC;
+		u8		startA, startX, startY, startP;
+		int		startCycle;
+		int		count;
+		Step	steps[IDLE_LOOP_MAX_OPS];
+
+	}; // IdleLoop
+
+	void StartIdleLoop(IdleLoop& loop, int numOps)
+	{
+		loop.startPC	= PC;
+		loop.startA		= A;
+		loop.startX		= X;
+		loop.startY		= Y;
+		loop.startP		= PF.get();
+		loop.startCycle	= frameCycle;
+		loop.count		= numOps;
+		busReads		= 0;
+
+	} // StartIdleLoop()
+
+	void RecordIdleLoop(IdleLoop& loop, int i, int cycles)
+	{
+		loop.steps[i].PC		= PC;
+		loop.steps[i].A			= A;
+		loop.steps[i].X			= X;
+		loop.steps[i].Y			= Y;
+		loop.steps[i].P			= PF.get();
+		loop.steps[i].cycles	= cycles;
+
+	} // RecordIdleLoop()
+
+	// True if the pass came back around untouched, and nothing it read can change by itself before
+	// the next event ( PPUSTATUS only with rendering off, where it changes at known points )
+	bool IsIdleLoop(IdleLoop& loop, u8 branchOp)
+	{
+		if (PC != loop.startPC || A != loop.startA || X != loop.startX || Y != loop.startY || PF.get() != loop.startP)
+		{
+			return false;
+		}
+		if (nmiFlag || irqFlag || busWritten)
+		{
+			return false;
+		}
+		if (busReads == 0)
+		{
+			return true;
+		}
+		return (busReads == 1) && ((lastBusRead & 0xE007) == 0x2002) && (branchOp == 0x10) && !PPU::IsRendering(ppu);
+
+	} // IsIdleLoop()
+
+	// Move the clock over as many passes as can go by before anything changes
+	void SkipIdleLoop(IdleLoop& loop)
+	{
+		int loopCycles	= frameCycle - loop.startCycle;
+		int limit		= (nextPPUEvent < timingCycle) ? nextPPUEvent : timingCycle;
+		if (busReads) // waiting on PPUSTATUS
+		{
+			int statusChange = ppuSynced + (PPU::DotsToStatusChange(ppu) / 3);
+			limit = (statusChange < limit) ? statusChange : limit;
+		}
+
+		// Always leave one real pass before the limit
+		SyncMapper();
+		while (!nmiFlag && !irqFlag && (frameCycle + (2 * loopCycles) < limit))
+		{
+			for (int i = 0; i < loop.count; i++)
+			{
+				IdleLoop::Step& step = loop.steps[i];
+				cpuCycle	+= step.cycles;
+				frameCycle	+= step.cycles;
+				PC			= step.PC;
+				A			= step.A;
+				X			= step.X;
+				Y			= step.Y;
+				PF.set(step.P);
+
+				// Mapper IRQ lands between the same two instructions it would have
+				SyncMapper();
+				if (irqFlag)
+				{
+					return;
+				}
+			} // for
+		} // while
+
+	} // SkipIdleLoop()
+
+	// Run instructions from PC while recording them as a new block. Only a run that gets to a real
+	// end is kept, one cut short by an interupt, a PPU event or the end of the frame is recorded again
+	// the next time through ( it would otherwise stay that short for good )
+	void RecordBlock(DecodedOp* first)
+	{
+		Block recording;
+		recording.count = 0;
+
+		DecodedOp* op = first;
+		while (true)
+		{
+			u16 opPC = PC;
+			recording.ops[recording.count++] = op;
+			RunOp(op);
+			if (EndsBlock(op->opCode) || recording.count == BLOCK_MAX_OPS)
+			{
+				break;
+			}
+
+			// Next instruction has to follow on in the same bank, or the block would not replay the same way
+			DecodedOp* next = LookupOp(PC);
+			if (!next || next != op + (u16)(PC - opPC) || ((next - opCache) / K_8) != ((first - opCache) / K_8))
+			{
+				break;
+			}
+
+			// Memory Map writes end every replay of this block at the same instruction anyway
+			if (busWritten)
+			{
+				break;
+			}
+			if (ShouldLeaveBlock())
+			{
+				return;
+			}
+			SyncMapper();
+			op = next;
+
+		} // while
+
+		recording.idleCandidate = IsIdleCandidate(&recording);
+		blockCache[first - opCache] = new Block(recording);
+
+	} // RecordBlock()
+
+#if DEBUG_COMPARE_BACKENDS
+	//-------------- Backend Comparison --------------//
+
+	// Every replayed instruction is run a second time through the interpreter from the same starting
+	// point. The replay's memory accesses are logged, Page Table writes are put back before the second
+	// run, and Memory Map accesses are played back off the log, so PPU, APU and Mapper only see one
+
+	static const int BUS_LOG_SIZE = 16;
+
+	enum BusLogMode
+	{
+		BUS_LOG_OFF,
+		BUS_LOG_RECORD,		// block backend, for real
+		BUS_LOG_REPLAY		// interpreter, checked against the log
+
+	}; // BusLogMode
+
+	// One memory access ( Page Table reads are left out, they are only ever plain memory )
+	struct BusAccess
+	{
+		u16		address;
+		u8		val;		// value read, or value written
+		u8		result;		// what the write handed back
+		bool	write;
+		u8*		mem;		// byte a Page Table write went to, nullptr for the Memory Map
+		u8		prev;		// what that Page Table write replaced
+		int		cycle;		// frameCycle the access was made on
+		int		cycles;		// cycles the Memory Map ran the clock on ( OAM DMA )
+
+	}; // BusAccess
+
+	BusLogMode	busLogMode		= BUS_LOG_OFF;
+	BusAccess	busLog[BUS_LOG_SIZE];
+	int			busLogCount		= 0;
+	int			busLogPos		= 0;
+	bool		busLogMismatch	= false;
+
+	// Everything an instruction can change on the CPU
+	struct CompareState
+	{
+		u8				A, X, Y, SP;
+		u16				PC;
+		ProcessorFlag	PF;
+		int				cpuCycle, frameCycle, opCycle;
+		int				ppuSynced, nextPPUEvent, mapperSynced, nextMapperEvent;
+		bool			nmiFlag, irqFlag, nmiCycled, irqCycled;
+		bool			busWritten;
+		int				busReads;
+		u16				lastBusRead;
+
+	}; // CompareState
+
+	void SaveCompareState(CompareState& state)
+	{
+		state.A					= A;
+		state.X					= X;
+		state.Y					= Y;
+		state.SP				= SP;
+		state.PC				= PC;
+		state.PF				= PF;
+		state.cpuCycle			= cpuCycle;
+		state.frameCycle		= frameCycle;
+		state.opCycle			= opCycle;
+		state.ppuSynced			= ppuSynced;
+		state.nextPPUEvent		= nextPPUEvent;
+		state.mapperSynced		= mapperSynced;
+		state.nextMapperEvent	= nextMapperEvent;
+		state.nmiFlag			= nmiFlag;
+		state.irqFlag			= irqFlag;
+		state.nmiCycled			= nmiCycled;
+		state.irqCycled			= irqCycled;
+		state.busWritten		= busWritten;
+		state.busReads			= busReads;
+		state.lastBusRead		= lastBusRead;
+
+	} // SaveCompareState()
+
+	void LoadCompareState(const CompareState& state)
+	{
+		A				= state.A;
+		X				= state.X;
+		Y				= state.Y;
+		SP				= state.SP;
+		PC				= state.PC;
+		PF				= state.PF;
+		cpuCycle		= state.cpuCycle;
+		frameCycle		= state.frameCycle;
+		opCycle			= state.opCycle;
+		ppuSynced		= state.ppuSynced;
+		nextPPUEvent	= state.nextPPUEvent;
+		mapperSynced	= state.mapperSynced;
+		nextMapperEvent	= state.nextMapperEvent;
+		nmiFlag			= state.nmiFlag;
+		irqFlag			= state.irqFlag;
+		nmiCycled		= state.nmiCycled;
+		irqCycled		= state.irqCycled;
+		busWritten		= state.busWritten;
+		busReads		= state.busReads;
+		lastBusRead		= state.lastBusRead;
+
+	} // LoadCompareState()
+
+	// ReadMemory/WriteMemory while the log is on
+	u8 LoggedAccess(u16 address, u8 val, bool write)
+	{
+		u8* page	= write ? writePages[address >> 8] : readPages[address >> 8];
+		u8* mem		= page ? &page[address & 0xFF] : nullptr;
+		BusLogMode mode = busLogMode;
+
+		if (mode == BUS_LOG_REPLAY && (write || !mem))
+		{
+			// Interpreter has to make the same access, on the same cycle
+			BusAccess* logged = (busLogPos < busLogCount) ? &busLog[busLogPos++] : nullptr;
+			if (!logged || logged->address != address || logged->write != write || logged->cycle != frameCycle
+				|| (write && logged->val != val))
+			{
+				busLogMismatch = true;
+				return val;
+			}
+
+			// Memory Map already saw this access, its answer comes off the log
+			if (!mem)
+			{
+				cpuCycle	+= logged->cycles;
+				frameCycle	+= logged->cycles;
+				return write ? logged->result : logged->val;
+			}
+		}
+
+		BusAccess access = { address, val, val, write, mem, mem ? *mem : (u8)0, frameCycle, 0 };
+
+		// Accesses the Memory Map makes itself ( OAM DMA ) belong to this one
+		busLogMode = BUS_LOG_OFF;
+		u8 result = write ? WriteMemory(address, val) : ReadMemory(address);
+		busLogMode = mode;
+
+		if (mode == BUS_LOG_RECORD && (write || !mem))
+		{
+			if (busLogCount == BUS_LOG_SIZE)
+			{
+				busLogMismatch = true;
+				return result;
+			}
+			access.cycles	= frameCycle - access.cycle;
+			access.result	= result;
+			if (!write)
+			{
+				access.val = result;
+			}
+			busLog[busLogCount++] = access;
+		}
+		return result;
+
+	} // LoggedAccess()
+
+	// Run a replayed instruction, then run it again through the interpreter and report anything
+	// the two left different. The block backend's result is the one that carries on
+	bool RunCompared(DecodedOp* op)
+	{
+		// Interpreter decodes the bytes in memory itself
+		u16 opPC = PC;
+		u8 bytes[3];
+		for (int i = 0; i < 3; i++)
+		{
+			u16 address = opPC + i;
+			bytes[i] = readPages[address >> 8][address & 0xFF];
+		} // for
+
+		CompareState before, replayed, interpreted;
+		SaveCompareState(before);
+
+		busLogMode		= BUS_LOG_RECORD;
+		busLogCount		= 0;
+		busLogMismatch	= false;
+		RunOp(op);
+		busLogMode		= BUS_LOG_OFF;
+		SaveCompareState(replayed);
+
+		// Put back what the replay wrote to memory, newest first
+		for (int i = busLogCount - 1; i >= 0; i--)
+		{
+			if (busLog[i].mem)
+			{
+				*busLog[i].mem = busLog[i].prev;
+			}
+		} // for
+
+		LoadCompareState(before);
+		busLogMode	= BUS_LOG_REPLAY;
+		busLogPos	= 0;
+		nmiCycled	= false;
+		irqCycled	= false;
+		opCycle		= frameCycle;
+		TICK; // OpCode fetch
+		PC++;
+		fetchOperand = &bytes[1];
+		(this->*opTable[bytes[0]])();
+		fetchOperand = nullptr;
+		busLogMode	= BUS_LOG_OFF;
+		SaveCompareState(interpreted);
+
+		std::stringstream report;
+		if (busLogMismatch || busLogPos != busLogCount)
+		{
+			report << " Bus";
+		}
+		if (replayed.A != interpreted.A)						{ report << " A"; }
+		if (replayed.X != interpreted.X)						{ report << " X"; }
+		if (replayed.Y != interpreted.Y)						{ report << " Y"; }
+		if (replayed.SP != interpreted.SP)						{ report << " SP"; }
+		if (replayed.PC != interpreted.PC)						{ report << " PC"; }
+		if (replayed.PF.get() != interpreted.PF.get())			{ report << " P"; }
+		if (replayed.frameCycle != interpreted.frameCycle)		{ report << " Cycles"; }
+
+		LoadCompareState(replayed);
+		if (report.str().empty())
+		{
+			return true;
+		}
+
+		std::stringstream message;
+		message << "Block Backend Mismatch $" << std::hex << std::uppercase << opPC << " Op $" << (int)bytes[0] << ":" << report.str();
+		Emulator::ShowMessage(message.str());
+		return false;
+
+	} // RunCompared()
+#endif
+
+	// Run the block at PC ( falling back to the interpreter off PRG ROM )
+	void RunBlock()
+	{
+		busWritten = false;
+		DecodedOp* first = LookupOp(PC);
+		if (!first)
+		{
+			Execute();
+			return;
+		}
+
+		Block* block = blockCache[first - opCache];
+		if (!block)
+		{
+			RecordBlock(first);
+			return;
+		}
+
+		// Idle loop candidates keep track of what each instruction left behind
+		IdleLoop loop;
+		if (block->idleCandidate)
+		{
+			StartIdleLoop(loop, block->count);
+		}
+
+		for (int i = 0; ; )
+		{
+#if DEBUG_COMPARE_BACKENDS
+			// Interpreter would have fetched this same instruction
+			if (LookupOp(PC) != block->ops[i])
+			{
+				Emulator::ShowMessage("Block Backend Mismatch");
+				useBlocks = false;
+				Execute();
+				return;
+			}
+			int startCycle = frameCycle;
+			if (!RunCompared(block->ops[i]))
+			{
+				useBlocks = false;
+				return;
+			}
+#else
+			int startCycle = frameCycle;
+			RunOp(block->ops[i]);
+#endif
+			if (block->idleCandidate)
+			{
+				RecordIdleLoop(loop, i, frameCycle - startCycle);
+			}
+			if (++i >= block->count)
+			{
+				break;
+			}
+			if (ShouldLeaveBlock())
+			{
+				return;
+			}
+			SyncMapper();
+
+		} // for
+
+		if (block->idleCandidate && IsIdleLoop(loop, block->ops[block->count - 1]->opCode))
+		{
+			SkipIdleLoop(loop);
+		}
+
+	} // RunBlock()
+
 	//Turn on the CPU, Reset Settings
 	void PowerOn()
 	{
@@ -1383,28 +2266,50 @@ namespace CPU
 		SP = 0xFD;
 		PF.set(0x34);
 		memset( ram, 0x0, sizeof(ram) );
+		BuildOpTable();
+
+		// 2K RAM is mirrored up to $1FFF
+		for (int i = 0; i < 4; i++)
+		{
+			MapPages(MEMMAP_RAM + (i * K_2), K_2, ram, ram);
+		} // for
 
 		nmiFlag = false;
 		irqFlag = false;
 
-		waitCycles	= 0;
 		cpuCycle	= 0;
 		timingCycle = 0;
+		framePacer	= 0;
+		frameCycle	= 0;
+		ppuSynced	= 0;
+		mapperSynced = 0;
+		nextPPUEvent = 0;
+		nextMapperEvent = mapperClocked ? 0 : INT_MAX;
 
 		PC = read16( interuptVector[InteruptType::RESET] ); // Set PC to start point
 
 	} // PowerOn()
 
-	//Run the CPU for roughly a Frame
-	void RunFrame()
+	// Run the CPU for one NES Frame
+	void EmulateFrame()
 	{
 		timingCycle += TOTAL_CYCLES;
-		while (timingCycle > 0)
+		while (frameCycle < timingCycle)
 		{
-			PPU_EXECUTE;
-			Execute();
+			// PPU only needs to be caught up before an instruction if it has an event due
+			if (frameCycle + 1 >= nextPPUEvent)
+			{
+				SyncPPU(frameCycle + 1);
+			}
 
-			Cartridge::SignalCPU();
+			if (useBlocks)
+			{
+				RunBlock();
+			}
+			else
+			{
+				Execute();
+			}
 
 			// Check for Interupts
 			if (nmiFlag && !nmiCycled)
@@ -1416,11 +2321,75 @@ namespace CPU
 				Interupt(InteruptType::IRQ);
 			}
 
+			// CPU-Counter Mappers are clocked once their next event is due
+			SyncMapper();
+
 		} // while
 
-		// Run APU
-		APU::RunFrame( elapsed() );
+		// Finish off the PPU and APU for this frame
+		SyncPPU(frameCycle);
+		APU::RunFrame(apu, elapsed());
+
+		// Counters restart from zero ( the Mapper can still be behind )
+		timingCycle -= frameCycle;
+		mapperSynced	-= frameCycle;
+		if (nextMapperEvent != INT_MAX)
+		{
+			nextMapperEvent -= frameCycle;
+		}
+		frameCycle		= 0;
+		ppuSynced		= 0;
+		ScheduleNextPPUEvent();
+
+	} // EmulateFrame()
+
+	// Run as many NES Frames as the emulation speed gives this host frame ( none when slowed down )
+	// Every frame is heard, the APU resamples them to the host's real time ( see APU::SetSpeed )
+	void RunFrame()
+	{
+		framePacer += emulatorSpeed;
+		while (framePacer >= 1.0f)
+		{
+			framePacer -= 1.0f;
+			EmulateFrame();
+
+		} // while
 
 	} // RunFrame()
 
+}; // CPU::Core
+
+//-------------- Console Wrappers --------------//
+
+namespace CPU
+{
+	// Every register, counter and cache starts out zeroed
+	Core* CreateCore()				{ return new Core(); }
+	void DestroyCore(Core* core)	{ delete core; }
+	void Connect(Core* cpu, Console& console)	{ cpu->Connect(console); }
+
+	// Straight to the Core ( from the rest of its Console )
+	u8 ReadMemory(Core* cpu, u16 address)	{ return cpu->ReadMemory(address); }
+	void Set_NMI(Core* cpu)					{ cpu->Set_NMI(); }
+	void Set_IRQ(Core* cpu)					{ cpu->Set_IRQ(); }
+	void Clear_IRQ(Core* cpu)				{ cpu->Clear_IRQ(); }
+	void MapPages(Core* cpu, u16 address, int size, u8* readMem, u8* writeMem) { cpu->MapPages(address, size, readMem, writeMem); }
+	void SetPRGROM(Core* cpu, u8* prg, u32 size)	{ cpu->SetPRGROM(prg, size); }
+	void SetMapper(Core* cpu, const MapperCalls* calls)	{ cpu->SetMapper(calls); }
+
+	// Run on the calling thread's current Console
+	u8 WriteMemory(u16 address, u8 val)		{ return Console::Current().cpu->WriteMemory(address, val); }
+	u8 WriteAPU_IO(u16 address, u8 val)		{ return Console::Current().cpu->WriteAPU_IO(address, val); }
+	u8 ReadAPU_IO(u16 address)				{ return Console::Current().cpu->ReadAPU_IO(address); }
+	void Interupt(InteruptType interupt)	{ Console::Current().cpu->Interupt(interupt); }
+	void Clear_NMI()						{ Console::Current().cpu->Clear_NMI(); }
+	void PowerOn()							{ Console::Current().cpu->PowerOn(); }
+	void RunFrame()							{ Console::Current().cpu->RunFrame(); }
+	void Tick()								{ Console::Current().cpu->Tick(); }
+	bool ToggleBlockBackend()				{ return Console::Current().cpu->ToggleBlockBackend(); }
+	int GetCycle()							{ return Console::Current().cpu->GetCycle(); }
+	void AdjustSpeed(double newSpeed)		{ Console::Current().cpu->AdjustSpeed(newSpeed); }
+	SaveData GrabSaveData()					{ return Console::Current().cpu->GrabSaveData(); }
+	void LoadSaveData(SaveData saveData)	{ Console::Current().cpu->LoadSaveData(saveData); }
+
 } // CPU
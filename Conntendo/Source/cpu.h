@@ -18,11 +18,20 @@
 #define MEMMAP_CARTRIDGE		0x4020
 #define MEMMAP_CARTRIDGE_END	0xFFFF
 
+struct MapperCalls; // mapper.h
+class Console; // console.h
+
 namespace CPU
 {
+	// Each Console owns a Core, the functions below taking no Core run on the current one ( see console.h )
+	class Core;
+	Core* CreateCore();
+	void DestroyCore(Core* core);
+	void Connect(Core* cpu, Console& console); // the Console's PPU, APU and controller ports
+
 	// Read-Write Functions
 	u8 WriteMemory(u16 address, u8 val);
-	u8 ReadMemory(u16 address);
+	u8 ReadMemory(Core* cpu, u16 address);
 	u8 WriteAPU_IO(u16 address, u8 val);
 	u8 ReadAPU_IO(u16 address);
 
@@ -71,10 +80,10 @@ namespace CPU
 	void Interupt(InteruptType interupt);
 
 	// Clear|Set Vectors
-	void Set_NMI();
+	void Set_NMI(Core* cpu);
 	void Clear_NMI();
-	void Set_IRQ();
-	void Clear_IRQ();
+	void Set_IRQ(Core* cpu);
+	void Clear_IRQ(Core* cpu);
 
 	enum Flags
 	{
@@ -89,43 +98,75 @@ namespace CPU
 	}; // ProcessorFlags
 
 	// Processor Flags
+	// Carry, Interupt Disable, Decimal and Overflow are kept as bools, Negative and Zero
+	// are only worked out from the last result when a Branch, PHP or Interupt asks for them
 	struct ProcessorFlag
 	{
-		bool flag[6];
+		bool flag[6];	// _ZERO and _NEGATIVE slots are unused
+		u16 nzResult;	// Zero if the low byte is 0, Negative if bit 7 or 8 is set
 
 	public:
-		bool& operator[] (const int i) { return flag[i]; }
+		bool& operator[] (const int i) { return flag[i]; } // Carry, Interupt Disable, Decimal, Overflow
+
+		// Negative and Zero come straight from an 8-bit result
+		inline void SetNZ(u8 val) { nzResult = val; }
+
+		// Negative and Zero set apart from each other ( BIT, PLP )
+		inline void SetNZ(bool negative, bool zero) { nzResult = (negative << 8) | !zero; }
+
+		inline bool Negative() const	{ return (nzResult & 0x180) != 0; }
+		inline bool Zero() const		{ return (u8)nzResult == 0; }
+
+		// Any Flag, Negative and Zero included
+		inline bool Test(const int i)
+		{
+			if (i == _NEGATIVE)
+			{
+				return Negative();
+			}
+			if (i == _ZERO)
+			{
+				return Zero();
+			}
+			return flag[i];
+
+		} // Test()
 
 		void set(u8 pf) 
 		{
 			flag[_CARRY]			= NTH_BIT(pf, 0); 
-			flag[_ZERO]				= NTH_BIT(pf, 1);
 			flag[_INTERUPT_DISABLE]	= NTH_BIT(pf, 2);
 			flag[_DECIMAL_MODE]		= NTH_BIT(pf, 3); 
 			flag[_OVER_FLOW]		= NTH_BIT(pf, 6); 
-			flag[_NEGATIVE]			= NTH_BIT(pf, 7);
+			SetNZ( NTH_BIT(pf, 7), NTH_BIT(pf, 1) );
 
 		} // set()
 
 		u8 get()
 		{
 			return	flag[_CARRY]			<< 0 |
-					flag[_ZERO]				<< 1 |
+					Zero()					<< 1 |
 					flag[_INTERUPT_DISABLE] << 2 |
 					flag[_DECIMAL_MODE]		<< 3 |
 										  0 << 4 |
 										  1 << 5 |
 					flag[_OVER_FLOW]		<< 6 |
-					flag[_NEGATIVE]			<< 7;
+					Negative()				<< 7;
 
 		} // get()
 
 	}; // ProcessorFlag
 
+	// Page Table ( 256 byte pages mapped straight onto memory, nullptr uses the Memory Map handlers )
+	void MapPages(Core* cpu, u16 address, int size, u8* readMem, u8* writeMem);
+	void SetPRGROM(Core* cpu, u8* prg, u32 size); // for the Decoded Instruction Cache
+	void SetMapper(Core* cpu, const MapperCalls* calls); // CPU-Counter Mappers are only clocked if they ask ( MAPPER_HOOK_CPU )
+
 	// Run Functions
 	void PowerOn();
 	void RunFrame();
 	void Tick();
+	bool ToggleBlockBackend(); // Interpreter is the reference
 
 	// Time Functions
 	int GetCycle();
@@ -141,11 +182,10 @@ namespace CPU
 		u8 Y;
 		u8 SP;
 		u16 PC;
-		ProcessorFlag PF;
+		u8 P; // Architectural Processor Status
 
 		int		cpuCycle;
-		int		waitCycles;
-		double	timingCycle;
+		int		timingCycle;
 
 		bool nmiFlag;
 		bool irqFlag;
@@ -157,7 +197,7 @@ namespace CPU
 
 		SaveData() {} // Default Constructor 
 
-		SaveData( u8 nRam[], u8 nA, u8 nX, u8 nY, u8 nSP, u16 nPC, ProcessorFlag nPF ) 
+		SaveData( u8 nRam[], u8 nA, u8 nX, u8 nY, u8 nSP, u16 nPC, u8 nP ) 
 		{
 			memcpy(ram, nRam, sizeof(ram) );
 			A = nA;
@@ -165,14 +205,13 @@ namespace CPU
 			Y = nY;
 			SP = nSP;
 			PC = nPC;
-			PF = nPF;
+			P = nP;
 		}
 
 		// Save Additional CPU Data ( so constructor parameter list isnt too bloated )
-		void SetCPUData(int nCycle, int nWaitCycles, double nTimingCycle, bool nNmiFlag, bool nIrqFlag, bool nNmiCycled, bool nIrqCycled)
+		void SetCPUData(int nCycle, int nTimingCycle, bool nNmiFlag, bool nIrqFlag, bool nNmiCycled, bool nIrqCycled)
 		{
 			cpuCycle = nCycle;
-			waitCycles = nWaitCycles;
 			timingCycle = nTimingCycle;
 			nmiFlag = nNmiFlag;
 			irqFlag = nIrqFlag;
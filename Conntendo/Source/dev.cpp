@@ -2,6 +2,10 @@
 
 // Conntendo
 #include "cpu.h"
+#include "ppu.h"
+#include "apu.h"
+#include "cartridge.h"
+#include "console.h"
 #include "emulator.h"
 #include "files.h"
 
@@ -15,6 +19,8 @@ namespace Dev
 #define BATCH_DURATION_SHORT 180
 #define BATCH_DURATION_LONG  360
 
+#define THREAD_TEST_FRAMES 600
+
 #define FRAME_TRACK 120
 #define FPS_FONT_HEIGHT 12
 
@@ -203,6 +209,111 @@ namespace Dev
 
 	} // BatchTestGames()
 
+	// One game played on a headless Console of its own thread
+	struct ConsoleRun
+	{
+		string romPath;
+		bool loaded;
+		u32 hash; // Console state after THREAD_TEST_FRAMES
+
+	}; // ConsoleRun
+
+	// FNV-1a, each field is hashed on its own so struct padding is left out
+	u32 HashBytes(u32 hash, const void* data, size_t size)
+	{
+		const u8* bytes = (const u8*)data;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash = (hash ^ bytes[i]) * 16777619u;
+		} // for
+		return hash;
+
+	} // HashBytes()
+
+	int RunHeadlessConsole(void* data)
+	{
+		ConsoleRun* run = (ConsoleRun*)data;
+		Console console;
+		console.MakeCurrent();
+
+		run->loaded = Cartridge::LoadROM(run->romPath.c_str());
+		if (!run->loaded)
+		{
+			return 0;
+		}
+		CPU::PowerOn();
+		PPU::Reset();
+		APU::Reset();
+		for (int i = 0; i < THREAD_TEST_FRAMES; i++)
+		{
+			CPU::RunFrame();
+		} // for
+
+		CPU::SaveData state = CPU::GrabSaveData();
+		u32 hash = 2166136261u;
+		hash = HashBytes(hash, state.ram, sizeof(state.ram));
+		hash = HashBytes(hash, &state.A, sizeof(state.A));
+		hash = HashBytes(hash, &state.X, sizeof(state.X));
+		hash = HashBytes(hash, &state.Y, sizeof(state.Y));
+		hash = HashBytes(hash, &state.SP, sizeof(state.SP));
+		hash = HashBytes(hash, &state.PC, sizeof(state.PC));
+		hash = HashBytes(hash, &state.P, sizeof(state.P));
+		hash = HashBytes(hash, &state.cpuCycle, sizeof(state.cpuCycle));
+		hash = HashBytes(hash, state.ppuData.ciRAM, sizeof(state.ppuData.ciRAM));
+		hash = HashBytes(hash, state.ppuData.cgRAM, sizeof(state.ppuData.cgRAM));
+		hash = HashBytes(hash, state.ppuData.oamMem, sizeof(state.ppuData.oamMem));
+		hash = HashBytes(hash, &state.ppuData.scanline, sizeof(state.ppuData.scanline));
+		hash = HashBytes(hash, &state.ppuData.cycle, sizeof(state.ppuData.cycle));
+		hash = HashBytes(hash, state.mapperData.prgRAM, sizeof(state.mapperData.prgRAM));
+		run->hash = hash;
+		return 0;
+
+	} // RunHeadlessConsole()
+
+	// Consoles share nothing, so two running at once must each end up where one running alone does
+	bool TestConsoleThreads(string romPath)
+	{
+		// Reference run, nothing else going on
+		ConsoleRun reference = { romPath, false, 0 };
+		SDL_Thread* thread = SDL_CreateThread(RunHeadlessConsole, "Console", &reference);
+		if (!thread)
+		{
+			Emulator::ShowMessage("Thread Test: Couldnt Start Thread");
+			return false;
+		}
+		SDL_WaitThread(thread, nullptr);
+		if (!reference.loaded)
+		{
+			Emulator::ShowMessage("Thread Test: Couldnt Load ROM");
+			return false;
+		}
+
+		// Two runs at the same time
+		ConsoleRun runs[2];
+		SDL_Thread* threads[2];
+		for (int i = 0; i < 2; i++)
+		{
+			runs[i]		= { romPath, false, 0 };
+			threads[i]	= SDL_CreateThread(RunHeadlessConsole, "Console", &runs[i]);
+		} // for
+
+		bool passed = true;
+		for (int i = 0; i < 2; i++)
+		{
+			if (!threads[i])
+			{
+				passed = false;
+				continue;
+			}
+			SDL_WaitThread(threads[i], nullptr);
+			passed = passed && runs[i].loaded && (runs[i].hash == reference.hash);
+		} // for
+
+		Emulator::ShowMessage(passed ? "Thread Test: PASSED" : "Thread Test: FAILED");
+		return passed;
+
+	} // TestConsoleThreads()
+
 	bool ToggleDisplayFPS()
 	{
 		return bDisplayFPS = !bDisplayFPS;
@@ -61,4 +61,7 @@ namespace Dev
 	bool BatchTestGames();
 	void RunDevClock();
 
+	// Console Thread Test ( the same game on two headless Consoles at once has to match a run on its own )
+	bool TestConsoleThreads(string romPath);
+
 } // Dev
\ No newline at end of file
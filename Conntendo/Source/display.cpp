@@ -0,0 +1,308 @@
+#include "display.h"
+
+// Conntendo
+#include "emulator.h"
+#include "ppu.h"
+#include "palette.h"
+#include "compositor.h"
+
+// C++
+#include <cmath>
+
+// NTSC Composite Signal Levels ( relative to sync ), from the NESdev Wiki
+const float SIGNAL_LOW[4]	= { 0.228f, 0.312f, 0.552f, 0.880f };
+const float SIGNAL_HIGH[4]	= { 0.616f, 0.840f, 1.100f, 1.100f };
+const float SIGNAL_BLACK	= 0.312f;
+const float SIGNAL_WHITE	= 1.100f;
+
+// NTSC Decoding
+#define NTSC_SAMPLES		8		// Composite samples in one pixel ( 12 make up a colour cycle )
+#define NTSC_HUE			3.9f	// Colour burst offset, in samples
+#define NTSC_PI				3.14159265f
+#define NTSC_LINE_PHASE		4		// Each line starts 341 * 8 samples after the one before it
+
+namespace Display
+{
+	Filter filter = Filter::Plain;
+
+	// Frames
+	u16 source[WIDTH * HEIGHT];
+	u32 frame[WIDTH * HEIGHT];
+	int framePhase = 0; // the skipped dot on odd frames makes the first line's phase alternate
+
+	// Conversion Tables ( rebuilt when the Palette changes )
+	u32 plainTable[PIXEL_INDICES];
+	float ntscTable[PIXEL_INDICES * NTSC_PHASES * NTSC_PARTS * 4];
+	u32 tableGeneration = 0;
+	bool tablesReady = false;
+
+	// Workers convert a band of lines each
+	struct Worker
+	{
+		SDL_Thread* thread;
+		SDL_sem* start;
+		int firstLine;
+		int lastLine;
+	};
+	Worker workers[DISPLAY_MAX_WORKERS];
+	int workerCount = 0;
+	SDL_sem* workersDone = nullptr;
+	bool workersBusy = false;
+	bool workersQuit = false;
+
+	void ConvertLines(int firstLine, int lastLine)
+	{
+		for (int y = firstLine; y < lastLine; y++)
+		{
+			if (filter == Filter::NTSC)
+			{
+				int phase = (framePhase + y * NTSC_LINE_PHASE) % NTSC_PHASES;
+				Compositor::NTSCLine(frame + y * WIDTH, source + y * WIDTH, ntscTable, phase, WIDTH);
+			}
+			else
+			{
+				Compositor::LookupLine(frame + y * WIDTH, source + y * WIDTH, plainTable, WIDTH);
+			}
+		}
+
+	} // ConvertLines()
+
+	int WorkerLoop(void* data)
+	{
+		Worker* worker = (Worker*)data;
+		while (true)
+		{
+			SDL_SemWait(worker->start);
+			if (workersQuit)
+			{
+				return 0;
+			}
+			ConvertLines(worker->firstLine, worker->lastLine);
+			SDL_SemPost(workersDone);
+		}
+
+	} // WorkerLoop()
+
+	void WaitForWorkers()
+	{
+		if (!workersBusy)
+		{
+			return;
+		}
+		for (int i = 0; i < workerCount; i++)
+		{
+			SDL_SemWait(workersDone);
+		}
+		workersBusy = false;
+
+	} // WaitForWorkers()
+
+	void Setup()
+	{
+		workerCount = SDL_GetCPUCount() - 1; // leave a core to the Emulator
+		workerCount = (workerCount < 1) ? 1 : (workerCount > DISPLAY_MAX_WORKERS) ? DISPLAY_MAX_WORKERS : workerCount;
+		workersDone = SDL_CreateSemaphore(0);
+		workersQuit = false;
+
+		for (int i = 0; i < workerCount; i++)
+		{
+			workers[i].firstLine	= (HEIGHT * i) / workerCount;
+			workers[i].lastLine		= (HEIGHT * (i + 1)) / workerCount;
+			workers[i].start		= SDL_CreateSemaphore(0);
+			workers[i].thread		= SDL_CreateThread(WorkerLoop, "Display", &workers[i]);
+			if (!workers[i].thread)
+			{
+				// Whatever could not be started is converted on the Emulator thread
+				SDL_DestroySemaphore(workers[i].start);
+				workerCount = i;
+				break;
+			}
+		}
+
+	} // Setup()
+
+	void Shutdown()
+	{
+		WaitForWorkers();
+		workersQuit = true;
+		for (int i = 0; i < workerCount; i++)
+		{
+			SDL_SemPost(workers[i].start);
+			SDL_WaitThread(workers[i].thread, nullptr);
+			SDL_DestroySemaphore(workers[i].start);
+		}
+		workerCount = 0;
+
+		if (workersDone)
+		{
+			SDL_DestroySemaphore(workersDone);
+			workersDone = nullptr;
+		}
+
+	} // Shutdown()
+
+	// Is the subcarrier at this phase inside the colour's half of the cycle
+	inline bool InColorPhase(int color, int phase)
+	{
+		return ((color + phase) % NTSC_PHASES) < (NTSC_PHASES / 2);
+
+	} // InColorPhase()
+
+	// Composite level of a pixel at one subcarrier phase, 0 at Black and 1 at White
+	float NTSCSignal(int pixel, int phase)
+	{
+		int color		= pixel & 0x0F;
+		int level		= (pixel >> 4) & 0x03;
+		int emphasis	= (pixel >> PIXEL_EMPHASIS_SHIFT) & 0x07;
+
+		// Colours $xE-$xF are Black
+		if (color > 0x0D)
+		{
+			level = 1;
+		}
+
+		float low	= SIGNAL_LOW[level];
+		float high	= SIGNAL_HIGH[level];
+		if (color == 0x00) { low = high; } // Greys only use the high level
+		if (color > 0x0C) { high = low; } // and $xD-$xF only the low one
+
+		float signal = InColorPhase(color, phase) ? high : low;
+
+		// Emphasis attenuates the signal during the emphasised colours' half cycles
+		if (((emphasis & 0x01) && InColorPhase(0x00, phase)) ||
+			((emphasis & 0x02) && InColorPhase(0x04, phase)) ||
+			((emphasis & 0x04) && InColorPhase(0x08, phase)))
+		{
+			signal *= EMPHASIS_DIM;
+		}
+
+		return (signal - SIGNAL_BLACK) / (SIGNAL_WHITE - SIGNAL_BLACK);
+
+	} // NTSCSignal()
+
+	// Decode a run of a pixel's samples into its share of the output colour
+	void NTSCDecode(float* entry, int pixel, int phase, int firstSample, int lastSample)
+	{
+		float y = 0.0f;
+		float i = 0.0f;
+		float q = 0.0f;
+		for (int s = firstSample; s < lastSample; s++)
+		{
+			int samplePhase = (phase + s) % NTSC_PHASES;
+			float level = NTSCSignal(pixel, samplePhase) / NTSC_PHASES;
+			float angle = NTSC_PI * (samplePhase + NTSC_HUE) / 6.0f;
+			y += level;
+			i += level * cosf(angle);
+			q += level * sinf(angle);
+		}
+
+		// YIQ to RGB, stored as Blue, Green, Red to match ARGB in memory
+		entry[0] = (y - 1.108545f * i + 1.709007f * q) * 255.0f;
+		entry[1] = (y - 0.274788f * i - 0.635691f * q) * 255.0f;
+		entry[2] = (y + 0.946882f * i + 0.623557f * q) * 255.0f;
+		entry[3] = 0.0f;
+
+	} // NTSCDecode()
+
+	// A pixel's 8 samples are its Body, the 2 either side of them are blended
+	// in from the previous pixel's Tail and the next pixel's Head
+	void BuildNTSCTable()
+	{
+		for (int pixel = 0; pixel < PIXEL_INDICES; pixel++)
+		{
+			for (int phase = 0; phase < NTSC_PHASES; phase++)
+			{
+				float* tail = NTSC_ENTRY(ntscTable, pixel, phase, NTSC_TAIL);
+				float* body = NTSC_ENTRY(ntscTable, pixel, phase, NTSC_BODY);
+				float* head = NTSC_ENTRY(ntscTable, pixel, phase, NTSC_HEAD);
+
+				if (pixel == PIXEL_DEBUG_HIGHLIGHT)
+				{
+					// Debug colour is drawn flat
+					u32 color = COLOR_DEBUG_HEX;
+					for (int c = 0; c < 4; c++)
+					{
+						tail[c] = head[c] = 0.0f;
+						body[c] = (float)((color >> (c * 8)) & 0xFF);
+					}
+					body[3] = 0.0f;
+					continue;
+				}
+
+				NTSCDecode(tail, pixel, phase, NTSC_SAMPLES - 2, NTSC_SAMPLES);
+				NTSCDecode(body, pixel, phase, 0, NTSC_SAMPLES);
+				NTSCDecode(head, pixel, phase, 0, 2);
+			}
+		}
+
+	} // BuildNTSCTable()
+
+	void BuildTables()
+	{
+		for (int i = 0; i < PIXEL_INDICES; i++)
+		{
+			plainTable[i] = (i == PIXEL_DEBUG_HIGHLIGHT) ? COLOR_DEBUG_HEX : Palette::GetColor(i & 0x3F, i >> PIXEL_EMPHASIS_SHIFT);
+		}
+
+		// Composite output comes from the signal itself, not the Palette
+		if (!tablesReady)
+		{
+			BuildNTSCTable();
+		}
+
+		tableGeneration = Palette::GetGeneration();
+		tablesReady = true;
+
+	} // BuildTables()
+
+	void SubmitFrame(const u16* pixels)
+	{
+		WaitForWorkers();
+
+		if (!tablesReady || tableGeneration != Palette::GetGeneration())
+		{
+			BuildTables();
+		}
+
+		memcpy(source, pixels, sizeof(source));
+		framePhase ^= NTSC_LINE_PHASE;
+
+		if (workerCount == 0)
+		{
+			ConvertLines(0, HEIGHT);
+			return;
+		}
+
+		workersBusy = true;
+		for (int i = 0; i < workerCount; i++)
+		{
+			SDL_SemPost(workers[i].start);
+		}
+
+	} // SubmitFrame()
+
+	const u32* GetFrame()
+	{
+		WaitForWorkers();
+		return frame;
+
+	} // GetFrame()
+
+	Filter GetFilter()
+	{
+		return filter;
+
+	} // GetFilter()
+
+	bool ToggleNTSC()
+	{
+		WaitForWorkers();
+		filter = (filter == Filter::NTSC) ? Filter::Plain : Filter::NTSC;
+
+		// Redo the current frame so a paused game shows the change
+		ConvertLines(0, HEIGHT);
+		return filter == Filter::NTSC;
+
+	} // ToggleNTSC()
+
+} // Display
@@ -0,0 +1,32 @@
+#pragma once
+//----------------------------------------------------------------//
+// Turns the PPU's colour index frames into ARGB, straight through
+// the Palette or through the NTSC Filter, on worker threads so the
+// conversion runs alongside the Emulator instead of inside the PPU
+//----------------------------------------------------------------//
+
+#include "common.h"
+
+#define DISPLAY_MAX_WORKERS	4
+
+namespace Display
+{
+	enum Filter
+	{
+		Plain,
+		NTSC
+	};
+
+	// Worker Threads
+	void Setup();
+	void Shutdown();
+
+	// Frames
+	void SubmitFrame(const u16* pixels);	// copies the frame and starts converting it
+	const u32* GetFrame();					// the last submitted frame ( waits for the workers )
+
+	// Filter
+	Filter GetFilter();
+	bool ToggleNTSC();
+
+} // Display
@@ -10,6 +10,7 @@
 #include "dev.h"
 #include "palette.h"
 #include "joypad.h"
+#include "display.h"
 
 // Resources
 #define FONT_NAME	"Sans.ttf"
@@ -51,6 +52,7 @@ namespace Emulator
 	// For Scanlines
 	u32 filterPixels[WIDTH_x2 * HEIGHT_x2]; // For drawing Scanlines ( needs to be twice as big for subpixels)
 	bool drawScanlines = false;
+	bool newFrame = false; // a frame is waiting on Display to be uploaded
 
 	// Messaging
 	DispMessage menuMessage;
@@ -88,6 +90,9 @@ namespace Emulator
 		// Setup Audio
 		APU::Init();
 
+		// Setup Frame Conversion
+		Display::Setup();
+
 		// Setup Emulator Messages
 		SetupText();
 		GetMessage()->renderer = renderer; 
@@ -255,6 +260,7 @@ namespace Emulator
 	bool ToggleDrawScanlines()
 	{
 		memset(filterPixels, COLOR_BACKDROP_HEX, sizeof(filterPixels));
+		newFrame = true;
 		return drawScanlines = !drawScanlines;
 
 	} // ToggleDrawScanlines
@@ -265,6 +271,35 @@ namespace Emulator
 		return bEnableFiltering;
 	} // ToggleScreenFilter()
 
+	bool ToggleNTSCFilter()
+	{
+		newFrame = true;
+		return Display::ToggleNTSC();
+
+	} // ToggleNTSCFilter()
+
+	// Frames left out are still run in full, just not drawn
+	void SetFrameSkip(int frames)
+	{
+		PPU::SetFrameSkip(frames);
+
+		string skipMessage = "FRAMESKIP: " + to_string(frames);
+		if (frames == FRAMESKIP_NONE)
+		{
+			skipMessage = "FRAMESKIP: OFF";
+		}
+		else if (frames == FRAMESKIP_AUTO)
+		{
+			skipMessage = "FRAMESKIP: AUTO";
+		}
+		else if (frames == FRAMESKIP_HEADLESS)
+		{
+			skipMessage = "FRAMESKIP: NO RENDER";
+		}
+		ShowMessage(skipMessage);
+
+	} // SetFrameSkip()
+
 	// Reset/PowerOn the NES
 	void Reset()
 	{
@@ -324,7 +359,7 @@ namespace Emulator
 	} // ReduceColor()
 
 	// Add Scanlines to VideoBuffer ( requires double resolution to access "sub pixels" )
-	void CreateScanlines( u32* pixels )
+	void CreateScanlines( const u32* pixels )
 	{
 		int oI = 0;
 		int oJ = 0;
@@ -409,9 +444,18 @@ namespace Emulator
 
 	} // RenderScreen()
 
-	// Send the rendered frame to the GUI 
-	void NewFrame( u32* pixels )
+	// Send the rendered frame to the GUI ( Display converts it while the Emulator carries on )
+	void NewFrame( u16* pixels )
 	{
+		Display::SubmitFrame(pixels);
+		newFrame = true;
+
+	} // NewFrame()
+
+	// Upload the converted frame to the Screen Textures
+	void UploadFrame()
+	{
+		const u32* pixels = Display::GetFrame();
 		if (drawScanlines)
 		{
 			CreateScanlines(pixels);
@@ -421,8 +465,9 @@ namespace Emulator
 		{
 			SDL_UpdateTexture(gameTexture, nullptr, pixels, WIDTH * sizeof(u32));
 		}
+		newFrame = false;
 
-	} // NewFrame()
+	} // UploadFrame()
 
 	// Send the rendered frame to the GUI 
 	void NewDebugFrame(u32* pixels, bool isNametable )
@@ -440,6 +485,11 @@ namespace Emulator
 
 	void CopyToRenderer( SDL_Renderer* renderer, SDL_Renderer* ntRenderer, SDL_Renderer* ptRenderer )
 	{
+		if (newFrame)
+		{
+			UploadFrame();
+		}
+
 		SDL_Texture* texture = (drawScanlines) ? filteredTexture : gameTexture;
 
 		// Tint Screen when Paused
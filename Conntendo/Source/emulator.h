@@ -125,7 +125,7 @@ namespace Emulator
 
 	// Screen Rendering
 	void RenderScreen(SDL_Renderer* renderer, SDL_Renderer* ntRenderer, SDL_Renderer* ptRenderer);
-	void NewFrame(u32* pixels);
+	void NewFrame(u16* pixels);
 	void NewDebugFrame(u32* pixels, bool isNametable );
 	void CopyToRenderer(SDL_Renderer* renderer, SDL_Renderer* ntRenderer, SDL_Renderer* ptRenderer);
 	bool ToggleDrawScanlines();
@@ -137,6 +137,8 @@ namespace Emulator
 	bool ToggleAllowNonIntegerScaling();
 	bool IsNonIntegerScalingAllowed();
 	bool ToggleScreenFilter();
+	bool ToggleNTSCFilter();
+	void SetFrameSkip(int frames);
 
 	// Emulator Path Sharing
 	string GetSavePath();
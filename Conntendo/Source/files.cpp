@@ -17,6 +17,21 @@
 // File and Folder Consts
 const int PATH_SIZE = 256; // Arbitrary Size
 
+// Savestates start with a header, so a state from a different SaveData layout is turned down
+// ( bump SAVE_VERSION whenever CPU::SaveData changes, 2: P is stored as the status byte )
+const u32 SAVE_MAGIC	= 0x5653434E; // "NCSV"
+const u32 SAVE_VERSION	= 2;
+
+struct SaveHeader
+{
+	u32 magic;
+	u32 version;
+	u32 dataSize; // sizeof(CPU::SaveData)
+
+	bool Matches() const { return magic == SAVE_MAGIC && version == SAVE_VERSION && dataSize == sizeof(CPU::SaveData); }
+
+}; // SaveHeader
+
 namespace Files
 {
 	// Get ROM from Path and return contents
@@ -47,6 +62,26 @@ namespace Files
 
 	} // ReadROMFile()
 
+	// Copy up to maxSize bytes of a file into buffer
+	int ReadBinaryFile(string filePath, u8* buffer, int maxSize)
+	{
+		FILE* readFile = fopen(filePath.c_str(), READ_BINARY);
+		if (readFile == nullptr)
+		{
+			return -1;
+		}
+
+		fseek(readFile, 0, SEEK_END);
+		int size = ftell(readFile);
+		rewind(readFile);
+
+		fread(buffer, (size < maxSize) ? size : maxSize, 1, readFile);
+		fclose(readFile);
+
+		return size;
+
+	} // ReadBinaryFile()
+
 	// Get relative emulator Path to desired Folder
 	void GetFolderPath(string* theFolderPath, const char* folderName)
 	{
@@ -194,6 +229,7 @@ namespace Files
 	bool CreateSaveState(string filePath)
 	{
 		CPU::SaveData saveData = CPU::GrabSaveData();
+		SaveHeader header = { SAVE_MAGIC, SAVE_VERSION, sizeof(CPU::SaveData) };
 
 #if USE_COMPRESSION
 		uLongf dataSize = sizeof(saveData);
@@ -205,13 +241,17 @@ namespace Files
 		FILE* out = fopen(filePath.c_str(), WRITE_BINARY);
 		if (out == nullptr)
 		{
+			free(dataCompressed);
 			return false;
 		}
+		fwrite(&header, sizeof(header), 1, out);
 		fwrite(dataCompressed, sizeDataCompressed, 1, out);
 		fclose(out);
 		out = nullptr;
+		free(dataCompressed);
 #else
 		ofstream saveState(filePath.c_str(), ios::binary);
+		saveState.write((char*)&header, sizeof(header));
 		saveState.write((char*)&saveData, sizeof(saveData));
 		saveState.close();
 #endif
@@ -222,6 +262,7 @@ namespace Files
 	bool LoadSaveState(string filePath)
 	{
 		CPU::SaveData testData;
+		SaveHeader header;
 
 #if USE_COMPRESSION
 		FILE* readFile = fopen(filePath.c_str(), READ_BINARY);
@@ -235,6 +276,14 @@ namespace Files
 		uLongf fileLength = ftell(readFile);
 		rewind(readFile);
 
+		// Turn down states saved by another version
+		if ( fileLength < sizeof(header) || fread(&header, sizeof(header), 1, readFile) != 1 || !header.Matches() )
+		{
+			fclose(readFile);
+			return false;
+		}
+		fileLength -= sizeof(header);
+
 		Bytef* dataReadInCompressed = (Bytef*)malloc(fileLength);
 		fread(dataReadInCompressed, fileLength, 1, readFile);
 
@@ -246,17 +295,39 @@ namespace Files
 		Bytef* dataUncompressed = (Bytef*)malloc(sizeDataUncompressed);
 		uLong sizeDataCompressed = fileLength;
 		int z_result = uncompress(dataUncompressed, &sizeDataUncompressed, dataReadInCompressed, sizeDataCompressed);
-		memcpy((char*)&testData, (char*)dataUncompressed, sizeof(testData));
+		bool intact = z_result == Z_OK && sizeDataUncompressed == sizeof(CPU::SaveData);
+		if (intact)
+		{
+			memcpy((char*)&testData, (char*)dataUncompressed, sizeof(testData));
+		}
+		free(dataReadInCompressed);
+		free(dataUncompressed);
 
+		if (!intact)
+		{
+			return false;
+		}
 		CPU::LoadSaveData(testData);
 #else
 		ifstream saveRead(filePath.c_str(), ios::binary);
-		if (saveRead.good())
+		if (!saveRead.good())
 		{
-			saveRead.read((char*)&testData, sizeof(testData));
-			saveRead.close();
-			CPU::LoadSaveData(testData);
+			return false;
+		}
+
+		// Turn down states saved by another version
+		saveRead.read((char*)&header, sizeof(header));
+		if ( !saveRead || !header.Matches() )
+		{
+			return false;
 		}
+		saveRead.read((char*)&testData, sizeof(testData));
+		if (!saveRead)
+		{
+			return false;
+		}
+		saveRead.close();
+		CPU::LoadSaveData(testData);
 #endif
 		return true;
 
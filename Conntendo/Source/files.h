@@ -50,6 +50,9 @@ namespace Files
 	// ROM Functions
 	u8* ReadROMFile(const char* romPath);
 
+	// Raw Binary Files ( returns the file size, -1 if it couldn't be opened )
+	int ReadBinaryFile(string filePath, u8* buffer, int maxSize);
+
 	// Images
 	void LoadDisplayImage(SDL_Renderer* renderer, const char* imgName, DisplayImage* imageTo);
 
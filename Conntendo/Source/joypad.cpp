@@ -5,6 +5,7 @@
 #include "ppu.h"
 #include "cartridge.h"
 #include "files.h"
+#include "console.h"
 
 // Config
 #define INPUT_CONFIG		"Input"
@@ -24,6 +25,47 @@
 #define SHORTCUT_DEBUG_DECR	SDL_SCANCODE_M
 #endif
 
+// One Console's controller ports
+class Joypad::Core
+{
+public:
+
+	u8 joypad_bits[2];  // Joypad shift registers
+	bool strobe;		// Joypad strobe latch
+	u8 input[2];		// Buttons held down, set by the host every frame
+
+	void ToggleStrobe(bool isHigh )
+	{
+		// Read the joypad data on strobe's transition 1 -> 0.
+		if ( strobe &&  !isHigh)
+		{
+			for (int i = 0; i < 2; i++)
+			{
+				joypad_bits[i] = input[i];
+			} // for
+		}
+		strobe = isHigh;
+
+	} // ToggleStrobe()
+
+	// Read joypad state (NES register format)
+	u8 GetInput(int plyr)
+	{
+		// When strobe is high, it keeps reading A:
+		if (strobe)
+		{
+			return 0x40 | ( input[0] & 0x01 );
+		}
+
+		// Get the status of a button and shift the register:
+		u8 joy				= 0x40 | ( joypad_bits[plyr] & 0x01 );
+		joypad_bits[plyr]	= 0x80 | ( joypad_bits[plyr] >> 1 );
+		return joy;
+
+	} // GetInput()
+
+}; // Joypad::Core
+
 namespace Joypad
 {
 	const int DEAD_ZONE = 13500;
@@ -35,11 +77,7 @@ namespace Joypad
 	// Recording Input
 	AssignInput assignInput;
 
-	u8 joypad_bits[2];  // Joypad shift registers
-	bool strobe;		// Joypad strobe latch
 	SDL_Joystick* joystick[] = { nullptr,nullptr };
-
-	u8 input[2] = { 0,0 };
 	bool buttonsPressed[256];
 
 	// Display Names for each Button
@@ -80,20 +118,6 @@ namespace Joypad
 
 	} // SetupInputConfig()
 
-	void ToggleStrobe(bool isHigh )
-	{
-		// Read the joypad data on strobe's transition 1 -> 0.
-		if ( strobe &&  !isHigh)
-		{
-			for (int i = 0; i < 2; i++)
-			{
-				joypad_bits[i] = input[i];
-			} // for
-		}
-		strobe = isHigh;
-
-	} // ToggleStrobe()
-
 	void SetJoystick( int index, SDL_Joystick* joy)
 	{
 		joystick[index] = joy;
@@ -109,22 +133,6 @@ namespace Joypad
 
 	} // InitJoysticks()
 
-	// Read joypad state (NES register format)
-	u8 GetInput(int plyr)
-	{
-		// When strobe is high, it keeps reading A:
-		if (strobe)
-		{
-			return 0x40 | ( input[0] & 0x01 );
-		}
-
-		// Get the status of a button and shift the register:
-		u8 joy				= 0x40 | ( joypad_bits[plyr] & 0x01 );
-		joypad_bits[plyr]	= 0x80 | ( joypad_bits[plyr] >> 1 );
-		return joy;
-
-	} // GetInput()
-
 	// Check if button is Pressed ( and previously wasnt )
 	bool CheckButton( const u8* state, int index )
 	{
@@ -280,6 +288,8 @@ namespace Joypad
 	// Take current Keyboard/Josytick State and apply it as NES Controller input, also Emulator Controls
 	u8 ProcessPlayerInput(const u8* state)
 	{
+		u8* input = Console::Current().joypad->input;
+
 		// Zero out NES Input
 		for (int i = 0; i < 2; i++)
 		{
@@ -411,4 +421,17 @@ namespace Joypad
 
 	} // LoadInputConfig()
 
+} // Joypad
+
+//-------------- Console Wrappers --------------//
+
+namespace Joypad
+{
+	Core* CreateCore()				{ return new Core(); }
+	void DestroyCore(Core* core)	{ delete core; }
+
+	// Straight to the Core ( from the CPU of its Console )
+	u8 GetInput(Core* joypad, int plyr)				{ return joypad->GetInput(plyr); }
+	void ToggleStrobe(Core* joypad, bool isHigh)	{ joypad->ToggleStrobe(isHigh); }
+
 } // Joypad
\ No newline at end of file
@@ -200,8 +200,12 @@ namespace Joypad
 	void SaveConfig();
 	void SetupConfig();
 
-	u8 GetInput(int n);
-	void ToggleStrobe(bool v);
+	// Each Console owns a Core ( controller ports ), read and strobed by the CPU of the same Console ( see console.h )
+	class Core;
+	Core* CreateCore();
+	void DestroyCore(Core* core);
+	u8 GetInput(Core* joypad, int n);
+	void ToggleStrobe(Core* joypad, bool v);
 
 	bool IsRecordingInput();
 	string GetCurrentRecording();
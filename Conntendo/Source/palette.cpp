@@ -1,5 +1,8 @@
 #include "palette.h"
 
+// Conntendo
+#include "files.h"
+
 namespace Palette
 {
 	const float BIAS = 0.66f;
@@ -57,15 +60,143 @@ namespace Palette
 		0XFFFFFF, 0XC7E5FF, 0XD9D9FF, 0XE9D1FF, 0XF9CEFF, 0XFFCCF1, 0XFFD4CB, 0XF8DFB1, 0XEDEAA4, 0XD6F4A4, 0XC5F8B8, 0XBEF6D3, 0XBFF1F1, 0XB9B9B9, 0X000000, 0X000000
 	};
 
+	// Loaded from a .pal file
+	u32 palette_Custom[EMPHASIS_COMBOS][64];
+	bool hasCustom = false;
+
 	// Default Palette
 	Colorspace palette = Colorspace::NES_COMP;
+	u32 generation = 0;
+
+	// The active Colorspace under every emphasis combination, so lookups are a single index
+	u32 colorTable[EMPHASIS_COMBOS][64];
+
+	// Dim the channels the emphasis bits ( 1 Red, 2 Green, 4 Blue ) don't cover
+	inline u32 Emphasize(u32 color, int emphasis)
+	{
+		float red	= (color >> 16) & 0xFF;
+		float green	= (color >> 8) & 0xFF;
+		float blue	= (color) & 0xFF;
+		if (emphasis & 0x01)
+		{
+			green	*= EMPHASIS_DIM;
+			blue	*= EMPHASIS_DIM;
+		}
+		if (emphasis & 0x02)
+		{
+			red		*= EMPHASIS_DIM;
+			blue	*= EMPHASIS_DIM;
+		}
+		if (emphasis & 0x04)
+		{
+			red		*= EMPHASIS_DIM;
+			green	*= EMPHASIS_DIM;
+		}
+		return ((u32)red << 16) | ((u32)green << 8) | (u32)blue;
+
+	} // Emphasize()
+
+	// 64 colours of the selected Colorspace
+	const u32* SourceColors()
+	{
+		switch (palette)
+		{
+		case Colorspace::NES_COMP:
+			return palette_NES_Comp;
+		case Colorspace::GAMEBOY:
+			return palette_GameBoy_64;
+		case Colorspace::VIRTUALBOY:
+			return palette_VirtualBoy_64;
+		case Colorspace::COMMODORE64:
+			return palette_Commodore64_64;
+		case Colorspace::CGA:
+			return palette_CGA_64;
+		case Colorspace::EGA:
+			return palette_EGA_64;
+		case Colorspace::CUSTOM:
+			return palette_Custom[0];
+		default:
+			return palette_NES_RGB;
+		} // switch
+
+	} // SourceColors()
+
+	bool BuildColorTable()
+	{
+		if (palette == Colorspace::CUSTOM) // emphasis already laid out by LoadPaletteFile()
+		{
+			memcpy(colorTable, palette_Custom, sizeof(colorTable));
+		}
+		else
+		{
+			const u32* colors = SourceColors();
+			for (int emphasis = 0; emphasis < EMPHASIS_COMBOS; emphasis++)
+			{
+				for (int i = 0; i < 64; i++)
+				{
+					colorTable[emphasis][i] = Emphasize(colors[i], emphasis);
+				} // for
+			} // for
+		}
+		generation++;
+		return true;
+
+	} // BuildColorTable()
+
+	// Default Colorspace is usable before GeneratePalette() runs
+	bool colorTableReady = BuildColorTable();
 
 	void SetPalette( Colorspace newCS )
 	{
+		if (newCS == Colorspace::CUSTOM && !hasCustom)
+		{
+			return;
+		}
 		palette = newCS;
+		BuildColorTable();
 
 	} // SetPalette()
 
+	// Load a 192 byte ( 64 colours ) or 1536 byte ( with all emphasis combinations ) .pal file
+	bool LoadPaletteFile(string filePath)
+	{
+		u8 rgb[PAL_SIZE_EMPHASIS];
+		int size = Files::ReadBinaryFile(filePath, rgb, sizeof(rgb));
+		if (size != PAL_SIZE && size != PAL_SIZE_EMPHASIS)
+		{
+			return false;
+		}
+
+		for (int i = 0; i < (size / 3); i++)
+		{
+			palette_Custom[i / 64][i % 64] = (rgb[i * 3] << 16) | (rgb[(i * 3) + 1] << 8) | rgb[(i * 3) + 2];
+		} // for
+		if (size == PAL_SIZE)
+		{
+			for (int emphasis = 1; emphasis < EMPHASIS_COMBOS; emphasis++)
+			{
+				for (int i = 0; i < 64; i++)
+				{
+					palette_Custom[emphasis][i] = Emphasize(palette_Custom[0][i], emphasis);
+				} // for
+			} // for
+		}
+		hasCustom = true;
+
+		if (palette == Colorspace::CUSTOM)
+		{
+			BuildColorTable();
+		}
+		return true;
+
+	} // LoadPaletteFile()
+
+	u32 GetGeneration()
+	{
+		return generation;
+
+	} // GetGeneration()
+
 	// Modify color value to increase contrast between simular colors in palette
 	inline u32 BiasColor(u32 tryColor)
 	{
@@ -178,34 +309,26 @@ namespace Palette
 			palette_CGA_64[i]			= palette_CGA[FourColor(i)];
 			palette_EGA_64[i]			= palette_EGA[MultiColor(i, 16,false)];
 		} // for
+		BuildColorTable();
 
 	} // GeneratePalette()
 
 	// Return color from currently selected palette
 	u32 GetColor(int index)
+	{
+		return GetColor(index, 0);
+
+	} // GetColor()
+
+	// Return color from currently selected palette with emphasis bits ( PPUMASK >> 5 ) applied
+	u32 GetColor(int index, int emphasis)
 	{
 		// Out of Range...is this the blacker than black stuff?? Punch Out and Bubble Bobble had issues
 		if (index < 0x0 || index > 0x3F)
 		{
 			index = PALETTE_BLACK; // Last Tile
 		}
-		switch (palette)
-		{
-		case Colorspace::NES_COMP:
-			return palette_NES_Comp[index];
-		case Colorspace::GAMEBOY:
-			return palette_GameBoy_64[index];
-		case Colorspace::VIRTUALBOY:
-			return palette_VirtualBoy_64[index];
-		case Colorspace::COMMODORE64:
-			return palette_Commodore64_64[index];
-		case Colorspace::CGA:
-			return palette_CGA_64[index];
-		case Colorspace::EGA:
-			return palette_EGA_64[index];
-		default:
-			return palette_NES_RGB[index];
-		} // switch
+		return colorTable[emphasis & 0x07][index];
 
 	} // GetColor()
 
@@ -13,6 +13,15 @@ namespace Palette
 #define PALETTE_RED			0x16 
 #define PALETTE_BLACK		0x3F
 
+// Colour Emphasis ( PPUMASK bits 5-7 ) dims the two other channels for each bit set
+#define EMPHASIS_COMBOS		8
+#define EMPHASIS_DIM		0.746f
+
+// User Palettes ( from the Resources Folder ), 64 colours or all 8 emphasis combinations of them
+#define PALETTE_FILE		"custom.pal"
+#define PAL_SIZE			(64 * 3)
+#define PAL_SIZE_EMPHASIS	(EMPHASIS_COMBOS * 64 * 3)
+
 	enum Colorspace
 	{
 		NES_COMP,
@@ -21,7 +30,8 @@ namespace Palette
 		VIRTUALBOY,
 		COMMODORE64,
 		CGA,
-		EGA
+		EGA,
+		CUSTOM
 	};
 
 	enum ColorBias
@@ -37,7 +47,10 @@ namespace Palette
 	};
 
 	void SetPalette(Colorspace palette);
+	bool LoadPaletteFile(string filePath);
 	u32 GetColor(int index);
+	u32 GetColor(int index, int emphasis);
 	void GeneratePalette();
+	u32 GetGeneration(); // changes whenever GetColor would return something different
 
 }
\ No newline at end of file
@@ -5,21 +5,26 @@
 #include "cartridge.h"
 #include "emulator.h"
 #include "palette.h"
+#include "compositor.h"
 #include "viewer.h"
+#include "console.h"
 
-namespace PPU
+// One Console's PPU: VRAM, OAM, registers, rendering state and Screen Buffer
+class PPU::Core
 {
+public:
+
 // Debug Consts
 #define UPDATE_DEBUG_RATE 30
 
 // Helper Macros
 #define IS_UNUSED_PALETTE_LOC	(address & 0x13) == 0x10
-#define IS_VISIBLE_AREA			(scanline < HEIGHT && xPos >= 0 && xPos < WIDTH)
+#define IS_VISIBLE_AREA			(scanline >= 0 && scanline < HEIGHT && xPos < WIDTH)
 #define IS_SPRITE_ENABLED		IS_SET(mask, PPU_MASK::SPR_ENABLE)
 #define IS_BACKGROUND_ENABLED	IS_SET(mask, PPU_MASK::BKD_ENABLE)
 #define IS_SPRITE_LEFTCOL		(IS_SET(mask, PPU_MASK::SPR_LEFTCOL_ENABLE) || xPos >= 8)
 #define IS_BACKGROUND_LEFTCOL	(IS_SET(mask, PPU_MASK::BKD_LEFTCOL_ENABLE) || xPos >= 8)
-#define BG_SHIFT_REGISTER		(ppuCycle >= 2 && ppuCycle <= 255) || (ppuCycle >= 322 && ppuCycle <= 337)
+#define BG_SHIFT_REGISTER(cycle)	(((cycle) >= 2 && (cycle) <= 255) || ((cycle) >= 322 && (cycle) <= 337))
 
 // Hex Modifers
 #define HOR_UPDATE  0x041F
@@ -48,6 +53,27 @@ namespace PPU
 	Mirroring mirrorMode;				// Nametable Mirroring Mode
 	bool ciRAMDisabled = false;			// Disable ciRAM, use cartridge RAM instead ( for gauntlet and rad racer etc )
 
+	// Page Table: what each 1K of $0000-$3EFF reads from, nullptr for the ones that go through the Mapper
+	u8* pages[16]		= {};			// CHR banks ( $0000-$1FFF ) then Nametables ( $2000-$3EFF )
+	u8* extraPages[4]	= {};			// Mapper's Nametable RAM, used when ciRAM is disabled
+
+	// Mapper, called without going through the Cartridge
+	const MapperCalls* mapper = nullptr;
+	bool signalScanline = false;		// Mapper subscribed to MAPPER_HOOK_SCANLINE ( Scanline IRQ counters )
+
+	// CPU of the same Console, for NMIs ( see Connect )
+	CPU::Core* cpu = nullptr;
+
+	// Frames stay in the Screen Buffer instead of going out to the Emulator and Debug Viewers ( see Console::headless )
+	bool headless = false;
+
+	void Connect(Console& console)
+	{
+		cpu			= console.cpu;
+		headless	= console.headless;
+
+	} // Connect()
+
 	// vRAM Variables
 	u8 ciRAM[K_2];						// VRAM for nametables ( enough for two )
 	u8 cgRAM[32];						// VRAM for palettes
@@ -57,8 +83,14 @@ namespace PPU
 	Sprite oam[SPRITE_LIMIT];			// Sprite Buffer
 	Sprite secOAM[SPRITE_LIMIT];		// Secondary Sprite Buffers 
 
+	// Screen Buffer pixel of each cgRAM entry ( Greyscale and Emphasis applied ), kept in step with cgRAM and PPUMASK
+	u16 paletteColors[32 + 1]; // one spare entry for the AVX2 gather
+
+	// What the Sprites in oam put on each pixel of the scanline ( SPRITE_PIXEL bits, see compositor.h )
+	u8 spriteLine[WIDTH];
+
 	// Screen Buffer
-	u32 pixelBuffer[WIDTH * HEIGHT];	// Screen Buffer 256x240
+	u16 pixelBuffer[WIDTH * HEIGHT];	// Screen Buffer 256x240 ( see PIXEL_EMPHASIS_SHIFT )
 
 	// vRAM Address
 	PPU_ADDRESS vRamAddr;
@@ -71,6 +103,12 @@ namespace PPU
 	int ppuCycle; 
 	bool isEvenFrame;
 
+	// Frame Skipping
+	int frameSkip		= FRAMESKIP_NONE;
+	int framesSkipped	= 0;
+	u32 lastDrawTicks	= 0;
+	bool drawFrame		= true; // pixels of this frame go to the Screen Buffer and out to the Emulator
+
 	// PPU Flags
 	u8 ctrl;
 	u8 mask;
@@ -91,10 +129,10 @@ namespace PPU
 	bool attrLatchHigh;
 
 	// PPU Temp Storage
-	static u16	renderAddress;	// address to character tables
-	static u8	memRes;			// Result of the operation
-	static u8	memBuffer;		// VRAM read buffer
-	static bool	memLatch;		// Detect second reading
+	u16		renderAddress;	// address to character tables
+	u8		memRes;			// Result of the operation
+	u8		memBuffer;		// VRAM read buffer
+	bool	memLatch;		// Detect second reading
 
 	// Dev Debug
 	int debugIncr = 0;
@@ -172,7 +210,7 @@ namespace PPU
 	void IncrementDebugValue(bool incr)
 	{
 		debugIncr = (incr) ? debugIncr + 1 : debugIncr - 1;
-		string verMessage = "Debug Val: " + std::to_string(PPU::GetDebugValue());
+		string verMessage = "Debug Val: " + std::to_string(GetDebugValue());
 		Emulator::ShowMessage(verMessage);
 
 	} // IncrementDebugValue()
@@ -220,6 +258,7 @@ namespace PPU
 	void LoadSaveData(PPU::SaveData loadedData)
 	{
 		mirrorMode	= loadedData.mirrorMode;
+		MapNameTables();
 
 		ctrl		= loadedData.ctrl;
 		mask		= loadedData.mask;
@@ -253,9 +292,11 @@ namespace PPU
 
 		memcpy(ciRAM, loadedData.ciRAM, sizeof(loadedData.ciRAM));
 		memcpy(cgRAM, loadedData.cgRAM, sizeof(loadedData.cgRAM));
+		UpdatePaletteColors();
 		memcpy(oamMem, loadedData.oamMem, sizeof(loadedData.oamMem));
 		memcpy(oam, loadedData.oam, sizeof(loadedData.oam));
 		memcpy(secOAM, loadedData.secOAM, sizeof(loadedData.secOAM));
+		BuildSpriteLine(nullptr);
 
 	} // LoadSaveData()
 
@@ -279,14 +320,73 @@ namespace PPU
 	} // GetNameTable()
 
 	// use Cartridge vRAM for Nametables instead of normal PPU ( Gauntlet )
-	void DisableCIRAM(bool toDisable) { ciRAMDisabled = toDisable; }
+	void DisableCIRAM(bool toDisable)
+	{
+		ciRAMDisabled = toDisable;
+		MapNameTables();
+
+	} // DisableCIRAM()
+
+	void SetCHRBanks(u8* const* banks)
+	{
+		for (int i = 0; i < 8; i++)
+		{
+			pages[i] = banks ? banks[i] : nullptr;
+		} // for
+
+	} // SetCHRBanks()
+
+	void SetCHRBank(int slot, u8* bank)
+	{
+		pages[slot] = bank;
+
+	} // SetCHRBank()
+
+	void SetMapper(const MapperCalls* calls)
+	{
+		mapper			= calls;
+		signalScanline	= calls && (calls->hooks & MAPPER_HOOK_SCANLINE);
+
+	} // SetMapper()
+
+	void SetNameTableRAM(u8* const* banks)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			extraPages[i] = banks ? banks[i] : nullptr;
+		} // for
+		MapNameTables();
+
+	} // SetNameTableRAM()
 
 	void SetMirrorMode(Mirroring newMode)
 	{
 		mirrorMode = newMode;
+		MapNameTables();
 
 	} // SetMirrorMode() 
 
+	// Point the Nametable pages at ciRAM or the Mapper's RAM, $3000-$3EFF mirrors $2000-$2EFF
+	void MapNameTables()
+	{
+		for (int i = 8; i < 16; i++)
+		{
+			if (ciRAMDisabled)
+			{
+				pages[i] = extraPages[i & 0x03];
+			}
+			else if (mirrorMode == FOURSCREEN)
+			{
+				pages[i] = nullptr; // needs the Cartridge's RAM, reported by GetNameTable
+			}
+			else
+			{
+				pages[i] = ciRAM + GetNameTable(i * K_1);
+			}
+		} // for
+
+	} // MapNameTables()
+
 	// Return which AddressSpace is being accessed in PPU
 	PPU_MEMMAP GetMapLoc(u16 address)
 	{
@@ -312,12 +412,12 @@ namespace PPU
 		switch (GetMapLoc(address))
 		{
 		case PPU_MEMMAP::CHR:
-			return Cartridge::WriteCHR(address, val);
+			return mapper->chr_write8(mapper->mapper, address, val);
 			break;
 		case PPU_MEMMAP::Nametable:
 			if (ciRAMDisabled)
 			{
-				Cartridge::WriteExtraRAM(address, val);
+				mapper->WriteExtraRAM(mapper->mapper, address, val);
 			}
 			return ciRAM[GetNameTable(address)] = val;
 			break;
@@ -327,6 +427,7 @@ namespace PPU
 				CLEAR_BIT(address, 0x10); // force to choose background palette
 			}
 			cgRAM[address & 0x1F] = val;
+			UpdatePaletteColor(address & 0x1F);
 			break;
 		} // switch
 
@@ -339,11 +440,39 @@ namespace PPU
 
 	} // GetPalette()
 
+	// Colour index plus the emphasis bits currently in PPUMASK
+	inline u16 PixelColor(u8 colorIndex)
+	{
+		// Out of Range...is this the blacker than black stuff?? Punch Out and Bubble Bobble had issues
+		if (colorIndex > 0x3F)
+		{
+			colorIndex = PALETTE_BLACK;
+		}
+		return colorIndex | ((mask >> 5) << PIXEL_EMPHASIS_SHIFT);
+
+	} // PixelColor()
+
+	inline void UpdatePaletteColor(int entry)
+	{
+		paletteColors[entry] = PixelColor(GetPalette(MEMMAP_PALETTE + entry));
+
+	} // UpdatePaletteColor()
+
+	void UpdatePaletteColors()
+	{
+		for (int i = 0; i < 32; i++)
+		{
+			UpdatePaletteColor(i);
+		} // for
+		paletteColors[32] = 0;
+
+	} // UpdatePaletteColors()
+
 	inline u8 ReadNameTable(u16 address)
 	{
 		if (ciRAMDisabled)
 		{
-			return Cartridge::ReadExtraRAM(address);
+			return mapper->ReadExtraRAM(mapper->mapper, address);
 		}
 		return ciRAM[GetNameTable(address)];
 
@@ -352,10 +481,19 @@ namespace PPU
 	// Read and return 8-Bit Value
 	inline u8 read8(u16 address)
 	{
+		if (address < MEMMAP_PALETTE)
+		{
+			u8* page = pages[address >> 10];
+			if (page)
+			{
+				return page[address & (K_1 - 1)];
+			}
+		}
+
 		switch (GetMapLoc(address))
 		{
 		case PPU_MEMMAP::CHR:
-			return Cartridge::ReadCHR(address);
+			return mapper->chr_read8(mapper->mapper, address);
 		case PPU_MEMMAP::Nametable:
 			return ReadNameTable(address);
 		case PPU_MEMMAP::Palette:
@@ -371,13 +509,26 @@ namespace PPU
 	{
 		if (!(ctrl & PPU_CTRL::NMI_ENABLED) && (val & PPU_CTRL::NMI_ENABLED) && (status & PPU_STATUS::VBLANK))
 		{
-			CPU::Set_NMI(); // Set NMI right away if vBlank set (but not repeatedly)
+			CPU::Set_NMI(cpu); // Set NMI right away if vBlank set (but not repeatedly)
 		}
 		ctrl = val;
 		tempAddr.nameTable = IS_SET(ctrl, PPU_CTRL::NAMETABLE_SLCT_A) | IS_SET(ctrl, PPU_CTRL::NAMETABLE_SLCT_B); // get lowest two bytes of PPUCTRL 
 
 	} // WriteCtrl()
 
+	// When writing PPUMASK
+	inline void WriteMask(u16 address, u8 val)
+	{
+		const u8 colorBits	= PPU_MASK::GREYSCALE | PPU_MASK::EMPHASIS_RED | PPU_MASK::EMPHASIS_GREEN | PPU_MASK::EMPHASIS_BLUE;
+		bool colorsChanged	= (mask ^ val) & colorBits;
+		mask = val;
+		if (colorsChanged)
+		{
+			UpdatePaletteColors();
+		}
+
+	} // WriteMask()
+
 	// When writing PPUSCROLL
 	inline void WriteScroll(u16 address, u8 val)
 	{
@@ -430,7 +581,7 @@ namespace PPU
 			WriteCtrl(address, val);
 			break;
 		case PPUMASK:
-			mask = val;
+			WriteMask(address, val);
 			break;
 		case OAMADDR:
 			oamAddress = val;
@@ -541,23 +692,76 @@ namespace PPU
 
 	} // SpriteHeight()
 
-	// Process one pixel, draw if its onscreen
-	void ProcessPixel()
+	// Put Sprites over the Background palette of one onscreen pixel, and draw it
+	void DrawPixel(u16 xPos, u8 palette)
 	{
 		// Pixel Data
-		u8 palette			= 0;
 		u8 objPalette		= 0;
-		u16 xPos			= ppuCycle - 2;
 		bool objPriority	= false; // if true, Sprites draw in front
 
 		// Debug Flags
 		bool toDebugAlpha = false;
 		bool toDebugHighlight = false;
 
+		// Sprites
+		if (IS_SPRITE_ENABLED && IS_SPRITE_LEFTCOL)
+		{
+			u8 sprite			= spriteLine[xPos];
+			objPalette			= sprite & SPRITE_PIXEL_PALETTE;
+			objPriority			= sprite & SPRITE_PIXEL_BEHIND;
+			toDebugAlpha		= bDebugFillSprites && (sprite & SPRITE_PIXEL_ALPHA);
+			toDebugHighlight	= bDebugHighlightSprites && objPalette;
+
+			// Check for SpriteZeroHit: when an opaque pixel of sprite 0 overlaps an opaque pixel of the background
+			if ((sprite & SPRITE_PIXEL_ZERO) && palette != 0 && IS_BACKGROUND_ENABLED )
+			{
+				SET_BIT(status, PPU_STATUS::SPR_ZERO_HIT);
+			}
+		}
+
+		// Skipped frame, the Sprite 0 Hit was all that mattered
+		if (!drawFrame)
+		{
+			return;
+		}
+
+		// Debug Disable Background
+		if (bDebugDisableBackground)
+		{
+			palette = 0x0;
+		}
+
+		// Whether to draw Sprite in front of Background
+		if ( objPalette && (palette == 0 || objPriority == 0) )
+		{
+			palette = objPalette;
+		}
+
+		u8 thePalette	= EitherRendering() ? palette : 0;
+		u16 finalColor	= paletteColors[thePalette];
+
+		// Use debug color instead of normal
+		if (toDebugAlpha)
+		{
+			finalColor = PixelColor(PALETTE_MAGENTA);
+		}
+
+		// Write Color value to current pixel
+		int currentPixel			= (scanline * 256) + xPos;
+		pixelBuffer[currentPixel]	= (toDebugHighlight) ? PIXEL_DEBUG_HIGHLIGHT : finalColor;
+
+	} // DrawPixel()
+
+	// Process one pixel, draw if its onscreen
+	void ProcessPixel()
+	{
+		u16 xPos = ppuCycle - 2;
+
 		// Only Draw Pixel in Visible Area
 		if (IS_VISIBLE_AREA)
 		{
 			// Background	
+			u8 palette = 0;
 			if (IS_BACKGROUND_ENABLED && IS_BACKGROUND_LEFTCOL)
 			{
 				palette = (NTH_BIT(bgShiftHigh, 15 - fineX) << 1) | NTH_BIT(bgShiftLow, 15 - fineX); // Get TileMap Data
@@ -566,87 +770,7 @@ namespace PPU
 					palette |= ((NTH_BIT(attrShiftHigh, 7 - fineX) << 1) | NTH_BIT(attrShiftLow, 7 - fineX)) << 2; // Get Correct Color Palette
 				}
 			}
-
-			// Sprites
-			if (IS_SPRITE_ENABLED && IS_SPRITE_LEFTCOL)
-			{
-				for (int i = SPRITE_LIMIT - 1; i >= 0; i--)
-				{
-					if (oam[i].index == 64)
-					{
-						continue;  // Void entry
-					}
-
-					u16 sprX = xPos - oam[i].posX;
-					if (sprX >= 8)
-					{
-						continue; // Not in range
-					}
-					if (oam[i].attr & 0x40)
-					{
-						sprX ^= 0x07; // Horizontal Flip
-					}
-
-					u8 xOffset = 7 - sprX;
-					if (bDebugDisableSpriteOffsetX)
-					{
-						xOffset = (oam[i].attr & 0x40) ?  xPos % 8 : (255 - xPos) % 8;
-					} 
-					u8 sprPalette = (NTH_BIT(oam[i].dataH, xOffset) << 1) | NTH_BIT(oam[i].dataL, xOffset);
-
-					// Zero is Transparent Pixel, Dont Draw
-					if (sprPalette == 0)
-					{
-						if (bDebugFillSprites)
-						{
-							toDebugAlpha = true;
-						}
-						continue;
-					}
-					if (bDebugHighlightSprites)
-					{
-						toDebugHighlight = true;
-					}
-
-					// Check for SpriteZeroHit: when an opaque pixel of sprite 0 overlaps an opaque pixel of the background
-					if (oam[i].index == 0 && palette != 0 && xPos != 0xFF && IS_BACKGROUND_ENABLED )
-					{
-						SET_BIT(status, PPU_STATUS::SPR_ZERO_HIT);
-					}
-
-					// Grab Sprite Attribute
-					sprPalette |= (oam[i].attr & 0x03) << 2;
-					objPalette  = sprPalette + 0x10;
-					objPriority = oam[i].attr & 0x20;
-
-				} // for
-			}
-
-			// Debug Disable Background
-			if (bDebugDisableBackground)
-			{
-				palette = 0x0;
-			}
-
-			// Whether to draw Sprite in front of Background
-			if ( objPalette && (palette == 0 || objPriority == 0) )
-			{
-				palette = objPalette;
-			}
-
-			u8 thePalette = EitherRendering() ? palette : 0;
-			u8 colorIndex = read8(MEMMAP_PALETTE + thePalette);
-
-			// Use debug color instead of normal
-			if (toDebugAlpha)
-			{
-				colorIndex = PALETTE_MAGENTA;
-			}
-
-			// Write Color value to current pixel
-			int currentPixel			= (scanline * 256) + xPos;
-			u32 finalColor				= (toDebugHighlight) ? COLOR_DEBUG_HEX : Palette::GetColor(colorIndex);
-			pixelBuffer[currentPixel]	= finalColor;
+			DrawPixel(xPos, palette);
 		}
 
 		// Perform Background Shifts
@@ -767,6 +891,7 @@ namespace PPU
 	void GrabSpritePixels()
 	{
 		u16 address;
+		const u8* rows[SPRITE_LIMIT];
 
 		// grab specific row of pixels (based on yPos) for each sprite on scanline
 		for (int i = 0; i < SPRITE_LIMIT; i++)
@@ -795,11 +920,77 @@ namespace PPU
 			// Grab Low and High Data
 			oam[i].dataL = read8(address + 0);
 			oam[i].dataH = read8(address + 8);
+			rows[i] = mapper->mapper->chr_decoded(address);
 
 		} // for
+		BuildSpriteLine(rows);
 
 	} // GrabSpritePixels()
 
+	// Lay the Sprites in oam out over the scanline once, so each pixel only has to look itself up
+	// rows holds each Sprite's decoded CHR row, without them the pixels come out of dataL / dataH
+	void BuildSpriteLine(const u8* rows[])
+	{
+		memset(spriteLine, 0, sizeof(spriteLine));
+
+		// Lower OAM index is in front, so go back to front
+		for (int i = SPRITE_LIMIT - 1; i >= 0; i--)
+		{
+			if (oam[i].index == 64)
+			{
+				continue;  // Void entry
+			}
+
+			for (int sprX = 0; sprX < 8; sprX++)
+			{
+				int xPos = oam[i].posX + sprX;
+				if (xPos >= WIDTH)
+				{
+					break; // Off the right edge
+				}
+
+				u8 xOffset = (oam[i].attr & 0x40) ? sprX : 7 - sprX; // Horizontal Flip
+				if (bDebugDisableSpriteOffsetX)
+				{
+					xOffset = (oam[i].attr & 0x40) ?  xPos % 8 : (255 - xPos) % 8;
+				} 
+				u8 sprPalette;
+				if (rows && rows[i])
+				{
+					sprPalette = rows[i][7 - xOffset]; // Decoded rows run left to right
+				}
+				else
+				{
+					sprPalette = (NTH_BIT(oam[i].dataH, xOffset) << 1) | NTH_BIT(oam[i].dataL, xOffset);
+				}
+
+				// Zero is Transparent Pixel, Dont Draw
+				u8& pixel = spriteLine[xPos];
+				if (sprPalette == 0)
+				{
+					pixel |= SPRITE_PIXEL_ALPHA;
+					continue;
+				}
+
+				// Sprite 0 never hits on the last pixel
+				if (oam[i].index == 0 && xPos != 0xFF)
+				{
+					pixel |= SPRITE_PIXEL_ZERO;
+				}
+
+				// Grab Sprite Attribute
+				sprPalette	|= (oam[i].attr & 0x03) << 2;
+				pixel		= (pixel & (SPRITE_PIXEL_ZERO | SPRITE_PIXEL_ALPHA)) | (sprPalette + 0x10);
+				if (oam[i].attr & 0x20)
+				{
+					pixel |= SPRITE_PIXEL_BEHIND;
+				}
+
+			} // for
+		} // for
+
+	} // BuildSpriteLine()
+
 	// Fill secondary OAM with the Sprite Info for the NEXT scanline
 	void EvaluateSprites()
 	{
@@ -930,12 +1121,163 @@ namespace PPU
 
 	} // CheckEndCycle()
 
-	void VisibleScanline(Scanline scan)
+	//-------------- Dot Table --------------//
+
+	// What a dot does, one entry per dot of each kind of scanline ( see BuildDotTable )
+	enum DotOp
 	{
-		// Sprites
-		switch (ppuCycle)
+		DOT_IDLE,
+
+		// Background shifts, with the fetch for ppuCycle % 8 ( 1-7, 0 )
+		DOT_SHIFT_NT_ADDRESS,
+		DOT_SHIFT_NT,
+		DOT_SHIFT_AT_ADDRESS,
+		DOT_SHIFT_AT,
+		DOT_SHIFT_LOW_ADDRESS,
+		DOT_SHIFT_LOW,
+		DOT_SHIFT_HIGH_ADDRESS,
+		DOT_SHIFT_HIGH,
+
+		// Pre-render and visible scanlines
+		DOT_LINE_START,			// 1: secondary OAM cleared ( and flags on the pre-render line )
+		DOT_VERT_BUMP,			// 256
+		DOT_HOR_UPDATE,			// 257: Sprite evaluation, Horizontal Position
+		DOT_SCANLINE_SIGNAL,	// 260: IRQ Signal to Mapper
+		DOT_VERT_UPDATE,		// 280-304 of the pre-render line
+		DOT_SPRITE_FETCH,		// 321
+		DOT_NT_FETCH,			// 338: Nametable fetch instead of attribute
+		DOT_NT_ADDRESS,			// 339: odd frames skip the next dot here
+		DOT_LINE_END,			// 340
+
+		// Everything else
+		DOT_FRAME_DONE,			// 240, 0: hand the frame over
+		DOT_VBLANK				// 241, 1: VBlank and NMI
+
+	}; // DotOp
+
+	enum DotRow
+	{
+		ROW_PRE,
+		ROW_VISIBLE,
+		ROW_POST,
+		ROW_VBLANK_START,
+		ROW_VBLANK,
+		ROW_TOTAL
+
+	}; // DotRow
+
+	u8 dotTable[ROW_TOTAL][CYCLE_END + 1];
+	u8 lineRows[SCANLINE_END + 1];			// by scanline + 1
+	Scanline lineTypes[SCANLINE_END + 1];	// by scanline + 1
+
+	void BuildDotTable()
+	{
+		memset(dotTable, DOT_IDLE, sizeof(dotTable));
+
+		// Pre-render and visible scanlines only differ on the cycles that handle scan == PRE
+		const u8 shiftOps[8] = {	DOT_SHIFT_HIGH, DOT_SHIFT_NT_ADDRESS, DOT_SHIFT_NT, DOT_SHIFT_AT_ADDRESS,
+									DOT_SHIFT_AT, DOT_SHIFT_LOW_ADDRESS, DOT_SHIFT_LOW, DOT_SHIFT_HIGH_ADDRESS };
+		for (int row = ROW_PRE; row <= ROW_VISIBLE; row++)
+		{
+			u8* dots = dotTable[row];
+			for (int cycle = 0; cycle <= CYCLE_END; cycle++)
+			{
+				if (BG_SHIFT_REGISTER(cycle))
+				{
+					dots[cycle] = shiftOps[cycle % 8];
+				}
+			} // for
+			dots[1]		= DOT_LINE_START;
+			dots[256]	= DOT_VERT_BUMP;
+			dots[257]	= DOT_HOR_UPDATE;
+			dots[260]	= DOT_SCANLINE_SIGNAL;
+			dots[321]	= DOT_SPRITE_FETCH;
+			dots[338]	= DOT_NT_FETCH;
+			dots[339]	= DOT_NT_ADDRESS;
+			dots[340]	= DOT_LINE_END;
+		} // for
+		for (int cycle = 280; cycle <= 304; cycle++)
+		{
+			dotTable[ROW_PRE][cycle] = DOT_VERT_UPDATE;
+		} // for
+		dotTable[ROW_POST][0]			= DOT_FRAME_DONE;
+		dotTable[ROW_VBLANK_START][1]	= DOT_VBLANK;
+
+		// Kind of each scanline
+		for (int line = SCANLINE_PRE; line < SCANLINE_END; line++)
+		{
+			u8& row			= lineRows[line + 1];
+			Scanline& type	= lineTypes[line + 1];
+			if (line == SCANLINE_PRE)
+			{
+				row		= ROW_PRE;
+				type	= Scanline::PRE;
+			}
+			else if (line <= SCANLINE_VISIBLE_END)
+			{
+				row		= ROW_VISIBLE;
+				type	= Scanline::VISIBLE;
+			}
+			else if (line == SCANLINE_POST)
+			{
+				row		= ROW_POST;
+				type	= Scanline::POST;
+			}
+			else
+			{
+				row		= (line == SCANLINE_NMI) ? ROW_VBLANK_START : ROW_VBLANK;
+				type	= Scanline::NMI;
+			}
+		} // for
+		lineRows[SCANLINE_END]	= ROW_VBLANK; // 261 should never be hit
+		lineTypes[SCANLINE_END]	= Scanline::Invalid;
+
+	} // BuildDotTable()
+
+	// Run what the current dot does
+	inline void RunDot(u8 op, Scanline scan)
+	{
+		switch (op)
 		{
-		case 1:
+		case DOT_IDLE:
+			break;
+
+		// Background
+		case DOT_SHIFT_NT_ADDRESS:
+			ProcessPixel();
+			GrabNameTable(true);
+			break;
+		case DOT_SHIFT_NT:
+			ProcessPixel();
+			GrabNameTable(false);
+			break;
+		case DOT_SHIFT_AT_ADDRESS:
+			ProcessPixel();
+			GrabAttributeTable(true);
+			break;
+		case DOT_SHIFT_AT:
+			ProcessPixel();
+			GrabAttributeTable(false);
+			break;
+		case DOT_SHIFT_LOW_ADDRESS:
+			ProcessPixel();
+			GrabBGLowLatch(true);
+			break;
+		case DOT_SHIFT_LOW:
+			ProcessPixel();
+			GrabBGLowLatch(false);
+			break;
+		case DOT_SHIFT_HIGH_ADDRESS:
+			ProcessPixel();
+			GrabBGHighLatch(true);
+			break;
+		case DOT_SHIFT_HIGH:
+			ProcessPixel();
+			GrabBGHighLatch(false);
+			break;
+
+		// Scanline Markers
+		case DOT_LINE_START: // No Shift Reloading
 			ClearOAM();
 			if (scan == PRE)
 			{
@@ -943,94 +1285,322 @@ namespace PPU
 				CLEAR_BIT(status, PPU_STATUS::SPR_ZERO_HIT);
 				CLEAR_BIT(status, PPU_STATUS::VBLANK);
 			}
+			renderAddress = NameTableAddress();
 			break;
-		case 257:
+		case DOT_VERT_BUMP:
+			ProcessPixel();
+			bgHigh = read8(renderAddress);
+			VertScroll();
+			break;
+		case DOT_HOR_UPDATE:
 			EvaluateSprites();
+			ProcessPixel();
+			ReloadShift();
+			HorUpdate();
+			break;
+		case DOT_SCANLINE_SIGNAL:
+			if (signalScanline && EitherRendering())
+			{
+				mapper->SignalScanline(mapper->mapper);
+			}
+			break;
+		case DOT_VERT_UPDATE:
+			VertUpdate();
 			break;
-		case 321:
+		case DOT_SPRITE_FETCH: // No Shift Reloading
 			GrabSpritePixels();
+			renderAddress = NameTableAddress();
+			break;
+		case DOT_NT_FETCH:
+			nameTable = read8(renderAddress);
+			break;
+		case DOT_NT_ADDRESS:
+			renderAddress = NameTableAddress();
+			CheckEndCycle(scan);
+			break;
+		case DOT_LINE_END:
+			CheckEndCycle(scan);
+			break;
+
+		// Outside Rendering
+		case DOT_FRAME_DONE:
+			if (headless)
+			{
+				break;
+			}
+			DrawDebugFrame();
+			if (drawFrame)
+			{
+				Emulator::NewFrame(pixelBuffer);
+			}
+			break;
+		case DOT_VBLANK: // Set VBlank at (2nd ppuCycle) of scanline 241
+			SET_BIT(status, PPU_STATUS::VBLANK);
+			if (IS_SET(ctrl, PPU_CTRL::NMI_ENABLED))
+			{
+				CPU::Set_NMI(cpu);
+			}
 			break;
 		} // switch
 
-		// Background
-		if (BG_SHIFT_REGISTER)
+	} // RunDot()
+
+	// One dot of the pre-render or a visible scanline
+	void VisibleScanline(Scanline scan)
+	{
+		RunDot(dotTable[(scan == PRE) ? ROW_PRE : ROW_VISIBLE][ppuCycle], scan);
+
+	} // VisibleScanline()
+
+	//-------------- Scanline Renderer --------------//
+
+	// Dots 1-257 of a visible scanline in one go. Only run when the CPU is behind the whole stretch,
+	// so no register write can land inside it ( a mid-scanline write syncs the PPU to that dot, which
+	// leaves the rest of the line to the per-dot path ). Fetches go out in the same order on the same
+	// dots as the per-dot path ( CHR latch and MMC5 Mappers watch them ), pixels are drawn once they are all in
+	bool useLineRenderer = true;
+
+	// Background palettes along the line: the 2 tiles prefetched on the previous scanline, then the 32 fetched on this one
+	u8 bgLine[8 * 34];
+
+	bool ToggleLineRenderer()
+	{
+		useLineRenderer = !useLineRenderer;
+		return useLineRenderer;
+
+	} // ToggleLineRenderer()
+
+	void SetFrameSkip(int frames)
+	{
+		frameSkip		= (frames > FRAMESKIP_MAX) ? FRAMESKIP_MAX : frames;
+		framesSkipped	= FRAMESKIP_MAX; // next frame is drawn
+
+	} // SetFrameSkip()
+
+	int GetFrameSkip()
+	{
+		return frameSkip;
+
+	} // GetFrameSkip()
+
+	// Decided at the start of each frame
+	bool ToDrawFrame()
+	{
+		bool toDraw = false;
+		if (frameSkip == FRAMESKIP_AUTO)
 		{
-			ProcessPixel();
-			switch (ppuCycle % 8)
+			u32 ticks	= SDL_GetTicks();
+			toDraw		= (framesSkipped >= FRAMESKIP_MAX) || ((ticks - lastDrawTicks) >= FRAMESKIP_AUTO_TICKS);
+			if (toDraw)
 			{
-			case 1:
-				GrabNameTable(true);
-				break;
-			case 2:
-				GrabNameTable(false);
-				break;
-			case 3:
-				GrabAttributeTable(true);
-				break;
-			case 4:
-				GrabAttributeTable(false);
-				break;
-			case 5:
-				GrabBGLowLatch(true);
-				break;
-			case 6:
-				GrabBGLowLatch(false);
-				break;
-			case 7:
-				GrabBGHighLatch(true);
-				break;
-			case 0:
-				GrabBGHighLatch(false);
-				break;
-			} // switch()
+				lastDrawTicks = ticks;
+			}
+		}
+		else if (frameSkip != FRAMESKIP_HEADLESS)
+		{
+			toDraw = (framesSkipped >= frameSkip);
+		}
+		framesSkipped = (toDraw) ? 0 : (framesSkipped + 1);
+		return toDraw;
+
+	} // ToDrawFrame()
+
+	// Sprite 0 Hit of the line without drawing it, Sprite 0 is always first in oam when it's on the line
+	void SpriteZeroLine(const u8* bgPixels)
+	{
+		if (oam[0].index != 0 || !IS_SPRITE_ENABLED || !IS_BACKGROUND_ENABLED)
+		{
+			return;
+		}
+
+		int first	= oam[0].posX;
+		int last	= (first + 8 < WIDTH) ? (first + 8) : WIDTH;
+		if (first < 8 && !(IS_SET(mask, PPU_MASK::SPR_LEFTCOL_ENABLE) && IS_SET(mask, PPU_MASK::BKD_LEFTCOL_ENABLE)))
+		{
+			first = 8;
+		}
+		for (int xPos = first; xPos < last; xPos++)
+		{
+			if ((spriteLine[xPos] & SPRITE_PIXEL_ZERO) && bgPixels[xPos])
+			{
+				SET_BIT(status, PPU_STATUS::SPR_ZERO_HIT);
+				return;
+			}
+		} // for
+
+	} // SpriteZeroLine()
+
+	// Background palette at position i ( 0-15 ) of the Shift Registers, ignoring Fine X
+	inline u8 ShiftRegisterPixel(int i)
+	{
+		int bit = 15 - i;
+		u8 palette = (NTH_BIT(bgShiftHigh, bit) << 1) | NTH_BIT(bgShiftLow, bit);
+		if (palette)
+		{
+			// Attribute bits shifted past the top were refilled from the latches
+			int attrBit = 7 - i;
+			u8 attr = (attrBit >= 0) ? (NTH_BIT(attrShiftHigh, attrBit) << 1) | NTH_BIT(attrShiftLow, attrBit) : (attrLatchHigh << 1) | attrLatchLow;
+			palette |= attr << 2;
+		}
+		return palette;
+
+	} // ShiftRegisterPixel()
+
+	// Palettes of the tile just fetched, 8 at a time from the decoded CHR when the Mapper keeps one
+	inline void LineTilePixels(u8* pixels, u16 patternAddress)
+	{
+		const u8* row	= mapper->mapper->chr_decoded(patternAddress);
+		u8 attr			= attrTable & 0x03;
+		if (!row)
+		{
+			Compositor::ExpandPlanes(pixels, bgLow, bgHigh, attr);
+			return;
+		}
+		for (int i = 0; i < 8; i++)
+		{
+			pixels[i] = row[i] ? (row[i] | (attr << 2)) : 0;
+		} // for
+
+	} // LineTilePixels()
+
+	// The whole line's pixels through the Compositor kernels, the column masks zero out the left 8
+	void ComposeLine(const u8* bgPixels)
+	{
+		u8 background[WIDTH];
+		u8 sprites[WIDTH];
+		u8 palettes[WIDTH];
+
+		if (IS_BACKGROUND_ENABLED)
+		{
+			memcpy(background, bgPixels, WIDTH);
 		}
 		else
 		{
-			if (ppuCycle == 256) // Vertical Bump
+			memset(background, 0, WIDTH);
+		}
+		if (IS_SPRITE_ENABLED)
+		{
+			memcpy(sprites, spriteLine, WIDTH);
+		}
+		else
+		{
+			memset(sprites, 0, WIDTH);
+		}
+		if (!IS_SET(mask, PPU_MASK::BKD_LEFTCOL_ENABLE))
+		{
+			memset(background, 0, 8);
+		}
+		if (!IS_SET(mask, PPU_MASK::SPR_LEFTCOL_ENABLE))
+		{
+			memset(sprites, 0, 8);
+		}
+
+		if (Compositor::MergeLine(palettes, background, sprites, WIDTH))
+		{
+			SET_BIT(status, PPU_STATUS::SPR_ZERO_HIT);
+		}
+		Compositor::ColorLine(pixelBuffer + (scanline * WIDTH), palettes, paletteColors, WIDTH);
+
+	} // ComposeLine()
+
+	void RenderScanline()
+	{
+		// Dot 1
+		ppuCycle = 1;
+		ClearOAM();
+		renderAddress = NameTableAddress();
+
+		// Skipped frames only need the Background under Sprite 0
+		const bool toDraw = drawFrame || (oam[0].index == 0);
+		if (toDraw)
+		{
+			for (int i = 0; i < 16; i++)
 			{
-				ProcessPixel();
-				bgHigh = read8(renderAddress);
-				VertScroll();
+				bgLine[i] = ShiftRegisterPixel(i);
+			} // for
+		}
+
+		// Dots 2-257, one tile of fetches at a time
+		for (int tile = 0; tile < 32; tile++)
+		{
+			int dot = (tile * 8) + 2;
+			bool lastTile = (tile == 31);
+
+			if (lastTile)
+			{
+				ppuCycle = 257;
+				EvaluateSprites();
 			}
-			else if (ppuCycle == 257) // Update Horizontal Position
+
+			// Eight Background Shifts
+			bgShiftLow		<<= 8;
+			bgShiftHigh		<<= 8;
+			attrShiftLow	= attrLatchLow	? 0xFF : 0x00;
+			attrShiftHigh	= attrLatchHigh	? 0xFF : 0x00;
+
+			ppuCycle = dot + 0;
+			GrabNameTable(false);
+			ppuCycle = dot + 1;
+			GrabAttributeTable(true);
+			ppuCycle = dot + 2;
+			GrabAttributeTable(false);
+			ppuCycle = dot + 3;
+			GrabBGLowLatch(true);
+			u16 patternAddress = renderAddress;
+			ppuCycle = dot + 4;
+			GrabBGLowLatch(false);
+			ppuCycle = dot + 5;
+			GrabBGHighLatch(true);
+			ppuCycle = dot + 6;
+			if (lastTile) // Vertical Bump
 			{
-				ProcessPixel();
-				ReloadShift();
-				HorUpdate();
+				bgHigh = read8(renderAddress);
+				VertScroll();
 			}
-			else if (ppuCycle >= 280 && ppuCycle <= 304) // Update Vertical Position
+			else
 			{
-				if (scan == Scanline::PRE)
-				{
-					VertUpdate();
-				}
+				GrabBGHighLatch(false);
 			}
-			else if (ppuCycle == 1) // No Shift Reloading
+			if (toDraw)
 			{
-				renderAddress = NameTableAddress();
-				if (scan == Scanline::PRE)
-				{
-					CLEAR_BIT(status, PPU_STATUS::VBLANK);
-				}
+				LineTilePixels(bgLine + (tile * 8) + 16, patternAddress);
 			}
-			else if (ppuCycle == 321 || ppuCycle == 339) // No Shift Reloading
+			ppuCycle = dot + 7;
+			if (lastTile) // Update Horizontal Position
 			{
-				renderAddress = NameTableAddress();
+				ReloadShift();
+				HorUpdate();
 			}
-			else if (ppuCycle == 338) // Nametable fetch instead of attribute:
+			else
 			{
-				nameTable = read8(renderAddress);
+				GrabNameTable(true);
 			}
-			CheckEndCycle(scan);
+		} // for
+		ppuCycle = 258;
+
+		if (!drawFrame)
+		{
+			SpriteZeroLine(bgLine + fineX);
+			return;
 		}
 
-		// IRQ Signal to Mapper based on Scanline
-		if (ppuCycle == 260 && EitherRendering())
+		// Pixels only read the Sprite line and palettes, neither of which the fetches touch
+		if (EitherRendering() && !bDebugFillSprites && !bDebugHighlightSprites && !bDebugDisableBackground)
 		{
-			Cartridge::SignalScanline();
+			ComposeLine(bgLine + fineX);
+			return;
 		}
+		for (u16 xPos = 0; xPos < WIDTH; xPos++)
+		{
+			u8 palette = 0;
+			if (IS_BACKGROUND_ENABLED && IS_BACKGROUND_LEFTCOL)
+			{
+				palette = bgLine[xPos + fineX];
+			}
+			DrawPixel(xPos, palette);
+		} // for
 
-	} // VisibleScanline()
+	} // RenderScanline()
 
 	// Draw DebugViewers
 	void DrawDebugFrame()
@@ -1053,81 +1623,200 @@ namespace PPU
 
 	Scanline GetScanlineType()
 	{
-		if (scanline == SCANLINE_PRE) // 261 should never be hit 
-		{
-			return Scanline::PRE;
-		}
-		else if (scanline >= 0 && scanline <= SCANLINE_VISIBLE_END)
+		return lineTypes[scanline + 1];
+
+	} // GetScanlineType()
+
+	// Run one PPU Cycle
+	void Execute()
+	{
+		// Run the Dot
+		const int line = scanline + 1;
+		RunDot(dotTable[lineRows[line]][ppuCycle], lineTypes[line]);
+
+		// Update ppuCycle and Scanline Counters
+		ppuCycle++;
+		if (ppuCycle > CYCLE_END)
 		{
-			return Scanline::VISIBLE;
+			ppuCycle = 0;
+			scanline++;
 		}
-		else if (scanline == SCANLINE_POST)
+		if (scanline >= SCANLINE_END)
 		{
-			return Scanline::POST;
+			scanline	= SCANLINE_PRE; 
+			isEvenFrame = !isEvenFrame;
+			drawFrame	= ToDrawFrame();
 		}
-		else if (scanline >= SCANLINE_NMI && scanline <= SCANLINE_NMI_END)
+
+	} // Execute()
+
+	// Number of PPU Cycles from here that Execute would spend only counting ( VBlank and the post-render
+	// scanline, or Horizontal Blank where just the Scanline Signal and the pre-render vertical reload happen )
+	int IdleDots()
+	{
+		const Scanline type = GetScanlineType();
+		if (type == Scanline::POST || type == Scanline::NMI)
 		{
-			return Scanline::NMI;
+			// Up to the VBlank flag or the pre-render scanline, handing the frame over is left to Execute
+			if ((scanline == SCANLINE_POST && ppuCycle == 0) || (scanline == SCANLINE_NMI && ppuCycle == 1))
+			{
+				return 0;
+			}
+			int toVBlank	= DotsTo(SCANLINE_NMI, 1) - 1;
+			int toPreRender	= DotsTo(SCANLINE_PRE, 0) - 1;
+			return (toVBlank < toPreRender) ? toVBlank : toPreRender;
 		}
-		return Scanline::Invalid;
+		else if ((type == Scanline::VISIBLE || type == Scanline::PRE) && ppuCycle >= 258 && ppuCycle <= 320)
 		{
-			Emulator::ShowMessage("Error, Invalid Scanline Hit"); // TODO: assert
+			return 321 - ppuCycle; // Sprite fetches start on 321
 		}
+		return 0;
 
-	} // GetScanlineType()
+	} // IdleDots()
 
-	// Execute a Cycle of a Scanline
-	void ScanlineCycle(Scanline scan)
+	// Move a number of IdleDots() ahead in one step
+	void SkipDots(int dots)
 	{
-		if (scan == Scanline::NMI && ppuCycle == 1 && scanline == SCANLINE_NMI) // Set VBlank at (2nd ppuCycle) of scanline 241
+		const Scanline type = GetScanlineType();
+		if (type == Scanline::VISIBLE || type == Scanline::PRE)
 		{
-			SET_BIT(status, PPU_STATUS::VBLANK);
-			if (IS_SET(ctrl, PPU_CTRL::NMI_ENABLED))
+			int endCycle = ppuCycle + dots;
+
+			// IRQ Signal to Mapper based on Scanline
+			if (signalScanline && ppuCycle <= 260 && endCycle > 260 && EitherRendering())
+			{
+				ppuCycle = 260;
+				mapper->SignalScanline(mapper->mapper);
+			}
+
+			// Update Vertical Position ( the same on each of 280-304, and the CPU can't write in between )
+			if (type == Scanline::PRE && ppuCycle <= 304 && endCycle > 280)
 			{
-				CPU::Set_NMI();
+				VertUpdate();
 			}
+			ppuCycle = endCycle;
+			return;
 		}
-		else if (scan == Scanline::POST && ppuCycle == 0)
+
+		// VBlank: nothing but the position changes
+		const int lineDots	= CYCLE_END + 1;
+		const int frameDots	= lineDots * (SCANLINE_END + 1);
+		int position		= ((scanline + 1) * lineDots) + ppuCycle + dots;
+		if (position >= frameDots)
 		{
-			DrawDebugFrame();
-			Emulator::NewFrame(pixelBuffer);
+			position	-= frameDots;
+			isEvenFrame = !isEvenFrame;
+			drawFrame	= ToDrawFrame();
 		}
-		else if (scan == Scanline::VISIBLE || scan == Scanline::PRE)
+		scanline	= (position / lineDots) - 1;
+		ppuCycle	= position % lineDots;
+
+	} // SkipDots()
+
+	// Run a number of PPU Cycles, whole visible scanlines go through the Scanline Renderer and idle stretches are skipped
+	void Run(int dots)
+	{
+		while (dots > 0)
 		{
-			VisibleScanline(scan);
-		}
+			if (useLineRenderer && ppuCycle == 1 && scanline >= 0 && scanline <= SCANLINE_VISIBLE_END && dots >= 257)
+			{
+				RenderScanline();
+				dots -= 257;
+				continue;
+			}
 
-	} // ScanlineCycle()
+			int idle = useLineRenderer ? IdleDots() : 0;
+			if (idle > 0)
+			{
+				idle = (idle < dots) ? idle : dots;
+				SkipDots(idle);
+				dots -= idle;
+			}
+			else
+			{
+				Execute();
+				dots--;
+			}
+		} // while
 
-	// Run one PPU Cycle
-	void Execute()
+	} // Run()
+
+	// Number of PPU cycles until a point in the frame is run ( counting the cycle itself )
+	int DotsTo(int line, int cycle)
 	{
-		// Run Scanline
-		const Scanline type = GetScanlineType();
-		ScanlineCycle(type);
+		const int lineDots	= CYCLE_END + 1;
+		const int frameDots	= lineDots * (SCANLINE_END + 1);
+		int position		= ((scanline + 1) * lineDots) + ppuCycle;
+		int target			= ((line + 1) * lineDots) + cycle;
+		return ((target >= position) ? (target - position) : (target - position + frameDots)) + 1;
 
-		// Update ppuCycle and Scanline Counters
-		ppuCycle++;
-		if (ppuCycle > CYCLE_END)
+	} // DotsTo()
+
+	// Number of PPU cycles until the next one the CPU can feel ( NMI at VBlank, Scanline IRQ signal )
+	int DotsToNextEvent()
+	{
+		int nextEvent = (CYCLE_END + 1) * (SCANLINE_END + 1); // nothing due this frame
+
+		// VBlank ( only matters if it will raise an NMI )
+		if (IS_SET(ctrl, PPU_CTRL::NMI_ENABLED))
 		{
-			ppuCycle = 0;
-			scanline++;
+			nextEvent = DotsTo(SCANLINE_NMI, 1);
 		}
-		if (scanline >= SCANLINE_END)
+
+		// Scanline Signal on cycle 260 of the pre-render and visible scanlines ( if the Mapper counts them )
+		if (signalScanline && EitherRendering())
 		{
-			scanline	= SCANLINE_PRE; 
-			isEvenFrame = !isEvenFrame;
+			int line	= (ppuCycle <= 260) ? scanline : scanline + 1;
+			int signal	= DotsTo((line > SCANLINE_VISIBLE_END) ? SCANLINE_PRE : line, 260);
+			if (signal < nextEvent)
+			{
+				nextEvent = signal;
+			}
 		}
+		return nextEvent;
 
-	} // Execute()
+	} // DotsToNextEvent()
+
+	// Number of PPU cycles until PPUSTATUS changes with rendering off ( VBlank set, flags cleared on the pre-render line )
+	int DotsToStatusChange()
+	{
+		int vBlank		= DotsTo(SCANLINE_NMI, 1);
+		int preRender	= DotsTo(SCANLINE_PRE, 1);
+		return (vBlank < preRender) ? vBlank : preRender;
+
+	} // DotsToStatusChange()
+
+	// Number of PPU cycles until Sprite Evaluation next reads OAM ( cycle 257 of the pre-render and visible scanlines )
+	int DotsToOAMRead()
+	{
+		int line = (ppuCycle <= 257) ? scanline : scanline + 1;
+		return DotsTo((line > SCANLINE_VISIBLE_END) ? SCANLINE_PRE : line, 257);
+
+	} // DotsToOAMRead()
+
+	// Same as 256 OAMDATA writes, wrapping around from oamAddress back to it
+	void WriteOAM(const u8* page)
+	{
+		int toEnd = 256 - oamAddress;
+		memcpy(oamMem + oamAddress, page, toEnd);
+		memcpy(oamMem, page + toEnd, oamAddress);
+		memRes = page[255];
+
+	} // WriteOAM()
 
 	void Reset()
 	{
+		BuildDotTable();
+
 		// Reset Counters
 		isEvenFrame	= true;
 		scanline	= SCANLINE_PRE; 
 		ppuCycle	= 0;
 
+		// First frame is drawn unless Headless
+		framesSkipped	= FRAMESKIP_MAX;
+		drawFrame		= ToDrawFrame();
+
 		// Reset PPU Registers
 		ctrl	= 0;
 		mask	= 0;
@@ -1136,11 +1825,69 @@ namespace PPU
 		// Reset RAM
 		memset(ciRAM, 0xFF, sizeof(ciRAM));
 		memset(oamMem, 0x00, sizeof(oamMem));
+		BuildSpriteLine(nullptr);
+		UpdatePaletteColors();
 
 		// Reset Screen Buffer
-		memset(pixelBuffer,	COLOR_BACKDROP_HEX, sizeof(pixelBuffer));
-		Viewer::Reset(); // Debug Screen Buffers
+		for (int i = 0; i < (WIDTH * HEIGHT); i++)
+		{
+			pixelBuffer[i] = PALETTE_BLACK;
+		} // for
+		if (!headless)
+		{
+			Viewer::Reset(); // Debug Screen Buffers
+		}
 
 	} // Reset()
 
+}; // PPU::Core
+
+//-------------- Console Wrappers --------------//
+
+namespace PPU
+{
+	// Every register, counter and buffer starts out zeroed
+	Core* CreateCore()				{ return new Core(); }
+	void DestroyCore(Core* core)	{ delete core; }
+	void Connect(Core* ppu, Console& console)	{ ppu->Connect(console); }
+
+	// Straight to the Core ( from the rest of its Console )
+	u8 WriteMemory(Core* ppu, u16 address, u8 val)	{ return ppu->WriteMemory(address, val); }
+	u8 ReadMemory(Core* ppu, u16 address)			{ return ppu->ReadMemory(address); }
+	void SetMirrorMode(Core* ppu, Mirroring mode)	{ ppu->SetMirrorMode(mode); }
+	void Run(Core* ppu, int dots)					{ ppu->Run(dots); }
+	int DotsToNextEvent(Core* ppu)					{ return ppu->DotsToNextEvent(); }
+	int DotsToStatusChange(Core* ppu)				{ return ppu->DotsToStatusChange(); }
+	int DotsToOAMRead(Core* ppu)					{ return ppu->DotsToOAMRead(); }
+	void WriteOAM(Core* ppu, const u8* page)		{ ppu->WriteOAM(page); }
+	int GetDebugValue(Core* ppu)					{ return ppu->GetDebugValue(); }
+	int GetCycle(Core* ppu)							{ return ppu->GetCycle(); }
+	int GetScanline(Core* ppu)						{ return ppu->GetScanline(); }
+	bool IsRendering(Core* ppu)						{ return ppu->IsRendering(); }
+	void DisableCIRAM(Core* ppu, bool toDisable)	{ ppu->DisableCIRAM(toDisable); }
+	void SetCHRBanks(Core* ppu, u8* const* banks)	{ ppu->SetCHRBanks(banks); }
+	void SetCHRBank(Core* ppu, int slot, u8* bank)	{ ppu->SetCHRBank(slot, bank); }
+	void SetMapper(Core* ppu, const MapperCalls* calls)	{ ppu->SetMapper(calls); }
+	void SetNameTableRAM(Core* ppu, u8* const* banks)	{ ppu->SetNameTableRAM(banks); }
+	SaveData GrabSaveData(Core* ppu)				{ return ppu->GrabSaveData(); }
+	void LoadSaveData(Core* ppu, SaveData loadedData)	{ ppu->LoadSaveData(loadedData); }
+
+	// Run on the calling thread's current Console
+	u8 DebugReadMemory(u16 address)			{ return Console::Current().ppu->DebugReadMemory(address); }
+	u16 GetNameTable(u16 address)			{ return Console::Current().ppu->GetNameTable(address); }
+	void Execute()							{ Console::Current().ppu->Execute(); }
+	bool ToggleLineRenderer()				{ return Console::Current().ppu->ToggleLineRenderer(); }
+	void SetFrameSkip(int frames)			{ Console::Current().ppu->SetFrameSkip(frames); }
+	int GetFrameSkip()						{ return Console::Current().ppu->GetFrameSkip(); }
+	void Reset()							{ Console::Current().ppu->Reset(); }
+	void ClearOAM()							{ Console::Current().ppu->ClearOAM(); }
+	void VisibleScanline(Scanline scan)		{ Console::Current().ppu->VisibleScanline(scan); }
+	bool ToggleHighlightSprites()			{ return Console::Current().ppu->ToggleHighlightSprites(); }
+	bool ToggleFillSprites()				{ return Console::Current().ppu->ToggleFillSprites(); }
+	bool ToggleDisableBackground()			{ return Console::Current().ppu->ToggleDisableBackground(); }
+	bool ToggleDisableSpriteOffset()		{ return Console::Current().ppu->ToggleDisableSpriteOffset(); }
+	void ToggleNametableViewer(bool toView)	{ Console::Current().ppu->ToggleNametableViewer(toView); }
+	void TogglePatternTableViewer(bool toView) { Console::Current().ppu->TogglePatternTableViewer(toView); }
+	void IncrementDebugValue(bool incr)		{ Console::Current().ppu->IncrementDebugValue(incr); }
+
 } // PPU
\ No newline at end of file
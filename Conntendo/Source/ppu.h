@@ -18,8 +18,29 @@
 #define MEMMAP_PALETTE			0x3F00
 #define MEMMAP_PALETTE_END		0x3FFF
 
+// Screen Buffer Pixels: 6 bit colour index, then the 3 PPUMASK emphasis bits ( turned into ARGB by Display )
+#define PIXEL_EMPHASIS_SHIFT	6
+#define PIXEL_DEBUG_HIGHLIGHT	0x200	// Sprite Highlight debug colour
+#define PIXEL_INDICES			0x201
+
+// Frame Skipping: how many frames to leave out between drawn ones, or one of the modes below
+#define FRAMESKIP_NONE			0
+#define FRAMESKIP_MAX			9		// most frames left out in a row
+#define FRAMESKIP_AUTO			-1		// draw no more often than the host can show them
+#define FRAMESKIP_HEADLESS		-2		// never draw ( for batch testing and bots )
+#define FRAMESKIP_AUTO_TICKS	12		// ms between drawn frames in Auto, a little under a 60Hz refresh
+
+struct MapperCalls; // mapper.h
+class Console; // console.h
+
 namespace PPU
 {
+	// Each Console owns a Core, the functions below taking no Core run on the current one ( see console.h )
+	class Core;
+	Core* CreateCore();
+	void DestroyCore(Core* core);
+	void Connect(Core* ppu, Console& console); // the Console's CPU, for NMIs
+
 	enum Scanline
 	{
 		Invalid,
@@ -41,17 +62,25 @@ namespace PPU
 	}; // Mirroring 
 
 	// Read-Write Functions
-	u8 WriteMemory(u16 address, u8 val);
-	u8 ReadMemory(u16 address);
+	u8 WriteMemory(Core* ppu, u16 address, u8 val);
+	u8 ReadMemory(Core* ppu, u16 address);
 	u8 DebugReadMemory(u16 address);
 
 	// NameTable Functions
 	u16 GetNameTable(u16 address);
-	void SetMirrorMode(Mirroring mode);
+	void SetMirrorMode(Core* ppu, Mirroring mode);
 
 	// Run Functions
 	void Execute();
+	void Run(Core* ppu, int dots);
+	bool ToggleLineRenderer(); // per-dot path is the reference
+	void SetFrameSkip(int frames); // skipped frames keep flags, Sprite 0 Hits, NMI and Mapper signals exact
+	int GetFrameSkip();
 	void Reset();
+	int DotsToNextEvent(Core* ppu); // for the CPU to know how long the PPU can be left behind
+	int DotsToStatusChange(Core* ppu);
+	int DotsToOAMRead(Core* ppu); // for OAM DMA to know if it can land all at once
+	void WriteOAM(Core* ppu, const u8* page); // OAM DMA, 256 bytes from oamAddress
 	void ClearOAM();
 
 	// Scanline Functions
@@ -66,16 +95,20 @@ namespace PPU
 	void TogglePatternTableViewer(bool toView); 
 
 	// Debug Functions
-	int GetDebugValue(); 
+	int GetDebugValue(Core* ppu); 
 	void IncrementDebugValue(bool incr);
 
 	// Debug PPU Values
-	int GetCycle();
-	int GetScanline();
-	bool IsRendering(); // for Mappers
+	int GetCycle(Core* ppu);
+	int GetScanline(Core* ppu);
+	bool IsRendering(Core* ppu); // for Mappers
 
 	// Special Case
-	void DisableCIRAM(bool toDisable);
+	void DisableCIRAM(Core* ppu, bool toDisable);
+	void SetCHRBanks(Core* ppu, u8* const* banks); // Mapper's 1K CHR bank pointers, nullptr to read through the Mapper
+	void SetCHRBank(Core* ppu, int slot, u8* bank); // one 1K CHR slot switched
+	void SetMapper(Core* ppu, const MapperCalls* calls); // Scanline Signals are only sent if the Mapper asks ( MAPPER_HOOK_SCANLINE )
+	void SetNameTableRAM(Core* ppu, u8* const* banks); // Mapper's 1K Nametable RAM pointers, nullptr to read through the Mapper
 
 	enum PPU_MEMMAP
 	{
@@ -243,7 +276,7 @@ namespace PPU
 
 	}; // SaveData
 
-	SaveData GrabSaveData();
-	void LoadSaveData( SaveData loadedData);
+	SaveData GrabSaveData(Core* ppu);
+	void LoadSaveData(Core* ppu, SaveData loadedData);
 
 } // PPU
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 // Conntendo
 #include "ppu.h"
+#include "cartridge.h"
 #include "palette.h"
 #include "emulator.h"
 
@@ -11,54 +12,49 @@ namespace Viewer
 	u32 nameTableBuffer[WIDTH_x2 * HEIGHT_x2];		// Screen Buffer 512x480
 	u32 patternTableBuffer[WIDTH * WIDTH];			// Screen Buffer 256x256
 
+	// Grab a row of 8 pixels ( palette indices, left to right ) from the decoded CHR,
+	// or decode it into planeRow when the Mapper doesn't keep one
+	const u8* GrabTileRow(u16 lowPlaneAddr, u8* planeRow)
+	{
+		const u8* row = Cartridge::DecodedCHR(lowPlaneAddr);
+		if (row)
+		{
+			return row;
+		}
+
+		u8 lowTileData	= PPU::DebugReadMemory(lowPlaneAddr);
+		u8 highTileData = PPU::DebugReadMemory(lowPlaneAddr + 8);
+		for (int i = 0; i < 8; i++)
+		{
+			planeRow[i] = (NTH_BIT(highTileData, 7 - i) << 1) | NTH_BIT(lowTileData, 7 - i);
+		} // for
+		return planeRow;
+
+	} // GrabTileRow()
+
 	// Draw Tile from NameTable
 	void DebugDrawTile(int x, int y, u16 ntData, u16 attrData)
 	{
-		u16 bgShiftL = 0;
-		u16 bgShiftH = 0;
-
-		u8 bgL = 0;
-		u8 bgH = 0;
-		u8 bgAddr = 0;
+		u8 planeRow[8];
 
 		for (int i = 0; i < 8; i++) // VERT
 		{
-			int iter = (i == 0) ? 0 : (i+1); // neccessary to grab first row
-
-			// Fetch low and high order byte of an 8x1 pixel sliver
+			// Fetch an 8x1 pixel sliver
 			bool bgTableSelected	= (PPU::DebugReadMemory(0x2000) & 0x10);
 			u16 bgTableAddress		= bgTableSelected ? K_4 : 0;
-			u16 bgAddr				= bgTableAddress + (ntData * 16) + iter;
-			bgL						= PPU::DebugReadMemory(bgAddr);
-			bgH						= PPU::DebugReadMemory(bgAddr+8);
-
-			// Fill bg Low and High with first two lines
-			if (i == 0)
-			{
-				bgShiftL	= bgL << 8;
-				bgShiftH	= bgH << 8;
-				bgAddr		= bgTableAddress + (ntData * 16) + 1;
-				bgL			= PPU::DebugReadMemory(bgAddr);
-				bgH			= PPU::DebugReadMemory(bgAddr + 8);
-			}
-
-			bgShiftL = (bgShiftL & 0xFF00) | bgL;
-			bgShiftH = (bgShiftH & 0xFF00) | bgH;
+			const u8* row			= GrabTileRow(bgTableAddress + (ntData * 16) + i, planeRow);
 
 			for (int j = 0; j < 8; j++) // HOR
 			{
-				u8 palette = 0;
 				int yOffset = (i + (y * 8));
 				int tileOffset = (WIDTH_x2 * yOffset);
 				int locOffset = (x * 8) + j;
 
-				palette = (NTH_BIT(bgShiftH, 15) << 1) | NTH_BIT(bgShiftL, 15); // Get TileMap Data
+				u8 palette = row[j]; // Get TileMap Data
 				if (palette)
 				{
 					palette |= attrData << 2; // 4 Bit Color
 				}
-				bgShiftL <<= 1;
-				bgShiftH <<= 1;
 
 				// Color Pixel
 				u8 colorIndex = PPU::DebugReadMemory(MEMMAP_PALETTE + palette);
@@ -104,15 +100,12 @@ namespace Viewer
 	} // DrawNametable()
 
 	// Draw Tile from Pattern Table
-	void DebugDrawTilePT(int offset, u8 lowTileData, u8 highTileData)
+	void DebugDrawTilePT(int offset, const u8* row)
 	{
 		for (int i = 0; i < 8; i++)
 		{
-			u8 colorIndex = (lowTileData & 0x01) + ((highTileData & 0x01) << 1);
-			lowTileData >>= 1;
-			highTileData >>= 1;
-			u8 index = GrabColorFromPalette(false, 0, colorIndex);
-			patternTableBuffer[offset + (8 - i)] = Palette::GetColor(index);
+			u8 index = GrabColorFromPalette(false, 0, row[i]);
+			patternTableBuffer[offset + i + 1] = Palette::GetColor(index);
 		} // for
 
 	} // DebugDrawTilePT()
@@ -121,6 +114,7 @@ namespace Viewer
 	{
 		u16 patternTab = isLeft ? 0 : K_4;
 		u16 tableOffset = isLeft ? 0 : 128;
+		u8 planeRow[8];
 		for (int h = 0; h < 16; h++) // VERT
 		{
 			for (int i = 0; i < 16; i++) // HOR
@@ -128,11 +122,8 @@ namespace Viewer
 				for (int j = 0; j < 8; j++) // Tile Row
 				{
 					u16 lowPlaneAddr = patternTab + j + (i * 16) + (WIDTH * h);
-					u16 highPlaneAddr = lowPlaneAddr + 8;
-					u8 lowTileData = PPU:: DebugReadMemory(lowPlaneAddr);
-					u8 highTileData = PPU:: DebugReadMemory(highPlaneAddr);
 					int offset = tableOffset + ((WIDTH * 8) * h) + (WIDTH * j) + (i * 8);
-					DebugDrawTilePT(offset, lowTileData, highTileData);
+					DebugDrawTilePT(offset, GrabTileRow(lowPlaneAddr, planeRow));
 				}
 			} // for
 		} // for
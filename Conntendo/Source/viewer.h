@@ -18,6 +18,7 @@ namespace Viewer
 	u8 GrabColorFromPalette(bool forSprite, u8 paletteIndex, u8 colorIndex);
 	void DebugDrawSolidTile(u8 row, u8 column, u32 color, u8 size);
 	u8 GrabAttribute(u16 attrTable, int tileX, int tileY);
+	const u8* GrabTileRow(u16 lowPlaneAddr, u8* planeRow);
 
 	// Setup
 	void Reset();